@@ -0,0 +1,78 @@
+/*
+ * CSSE2310 A1
+ * UQWordLadder
+ * Hardware cache-miss counter, where the kernel and CPU provide one.
+ */
+
+#include <string.h>
+#include <unistd.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include "cacheCounter.h"
+
+/* cache_counter_open()
+ * --------------------
+ * Opens a perf counter of cache misses made by this thread in user space.
+ *
+ * Returns: the counter, or CACHE_COUNTER_UNAVAILABLE if perf events are not
+ * 	supported or not permitted (as in many containers and VMs).
+ */
+int cache_counter_open(void) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    int counter = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    return counter < 0 ? CACHE_COUNTER_UNAVAILABLE : counter;
+}
+
+/* cache_counter_start()
+ * ---------------------
+ * Resets a counter to zero and starts counting.
+ *
+ * counter: the counter from cache_counter_open().
+ */
+void cache_counter_start(int counter) {
+    if (counter != CACHE_COUNTER_UNAVAILABLE) {
+	ioctl(counter, PERF_EVENT_IOC_RESET, 0);
+	ioctl(counter, PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+/* cache_counter_stop()
+ * --------------------
+ * Stops counting.
+ *
+ * counter: the counter from cache_counter_open().
+ *
+ * Returns: the number of cache misses since cache_counter_start(), or
+ * 	CACHE_COUNTER_UNAVAILABLE if they could not be counted.
+ */
+long long cache_counter_stop(int counter) {
+    if (counter == CACHE_COUNTER_UNAVAILABLE) {
+	return CACHE_COUNTER_UNAVAILABLE;
+    }
+    ioctl(counter, PERF_EVENT_IOC_DISABLE, 0);
+    long long misses;
+    if (read(counter, &misses, sizeof(misses)) != sizeof(misses)) {
+	return CACHE_COUNTER_UNAVAILABLE;
+    }
+    return misses;
+}
+
+/* cache_counter_close()
+ * ---------------------
+ * Closes a counter.
+ *
+ * counter: the counter from cache_counter_open().
+ */
+void cache_counter_close(int counter) {
+    if (counter != CACHE_COUNTER_UNAVAILABLE) {
+	close(counter);
+    }
+}
@@ -0,0 +1,17 @@
+/*
+ * CSSE2310 A1
+ * UQWordLadder
+ * Hardware cache-miss counter, where the kernel and CPU provide one.
+ */
+
+#ifndef CACHE_COUNTER_H
+#define CACHE_COUNTER_H
+
+#define CACHE_COUNTER_UNAVAILABLE (-1)
+
+int cache_counter_open(void);
+void cache_counter_start(int counter);
+long long cache_counter_stop(int counter);
+void cache_counter_close(int counter);
+
+#endif
@@ -0,0 +1,299 @@
+/*
+ * CSSE2310 A1
+ * UQWordLadder
+ * Deletion-neighbourhood index for ladders which may add or remove letters.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "deletionIndex.h"
+#include "lexicon.h"
+
+#define KEY_EMPTY 0
+#define LETTER_BITS 5
+#define HASH_MULTIPLIER 0x9E3779B97F4A7C15ull
+
+/* A deletion of one word, before the postings are grouped by key. */
+typedef struct {
+    uint64_t key;
+    uint32_t ref;
+} Entry;
+
+/* deletion_key()
+ * --------------
+ * Packs a word with one letter removed into an integer key, five bits per
+ * 	letter. Letters are stored as 1 to 26 so that keys of different
+ * 	lengths never collide and no key is KEY_EMPTY.
+ *
+ * word: the upper-case word.
+ * length: the number of letters in word.
+ * skip: the position of the letter to leave out, or -1 to keep them all.
+ *
+ * Returns: the packed key.
+ */
+static uint64_t deletion_key(const char* word, int length, int skip) {
+    uint64_t key = 0;
+    for (int i = 0; i < length; i++) {
+	if (i != skip) {
+	    key = (key << LETTER_BITS) | ((word[i] - 'A' + 1) & 0x1F);
+	}
+    }
+    return key;
+}
+
+/* key_slot()
+ * ----------
+ * Returns: the first hash table slot to probe for key.
+ */
+static uint32_t key_slot(const DeletionIndex* index, uint64_t key) {
+    return (uint32_t)((key * HASH_MULTIPLIER) >> 32) & (index->tableSize - 1);
+}
+
+/* compare_entries()
+ * -----------------
+ * qsort() comparator which orders entries by key, then by word reference.
+ */
+static int compare_entries(const void* first, const void* second) {
+    const Entry* a = first;
+    const Entry* b = second;
+    if (a->key != b->key) {
+	return a->key < b->key ? -1 : 1;
+    }
+    return (a->ref > b->ref) - (a->ref < b->ref);
+}
+
+/* compare_refs()
+ * --------------
+ * qsort() comparator for word references, which orders them by length and
+ * 	then by the third field (an id or a file position).
+ */
+static int compare_refs(const void* first, const void* second) {
+    uint32_t a = *(const uint32_t*)first;
+    uint32_t b = *(const uint32_t*)second;
+    return (a > b) - (a < b);
+}
+
+/* deletion_index_build()
+ * ----------------------
+ * Builds the deletion index over all words of the given lengths.
+ *
+ * dictionaries: an array of dictionaries indexed by word length. It must
+ * 	outlive the index.
+ * minLength: the shortest word length to index.
+ * maxLength: the longest word length to index.
+ *
+ * Returns: a pointer to the new index.
+ */
+DeletionIndex* deletion_index_build(Dictionary** dictionaries, int minLength,
+	int maxLength) {
+    size_t numEntries = 0;
+    for (int length = minLength; length <= maxLength; length++) {
+	numEntries += (size_t)dictionaries[length]->numWords * length;
+    }
+    Entry* entries = malloc(sizeof(Entry) * (numEntries + 1));
+    size_t next = 0;
+    for (int length = minLength; length <= maxLength; length++) {
+	Dictionary* dict = dictionaries[length];
+	for (int id = 0; id < dict->numWords; id++) {
+	    const char* word = dictionary_word(dict, id);
+	    for (int i = 0; i < length; i++) {
+		entries[next].key = deletion_key(word, length, i);
+		entries[next++].ref = DELETION_REF(length, i, id);
+	    }
+	}
+    }
+    qsort(entries, numEntries, sizeof(Entry), compare_entries);
+
+    DeletionIndex* index = malloc(sizeof(DeletionIndex));
+    index->dictionaries = dictionaries;
+    index->minLength = minLength;
+    index->maxLength = maxLength;
+    index->postings = malloc(sizeof(uint32_t) * (numEntries + 1));
+    size_t numKeys = 0;
+    for (size_t i = 0; i < numEntries; i++) {
+	index->postings[i] = entries[i].ref;
+	if (i == 0 || entries[i].key != entries[i - 1].key) {
+	    numKeys++;
+	}
+    }
+    index->tableSize = 2;
+    while (index->tableSize < numKeys * 2) {
+	index->tableSize <<= 1;
+    }
+    index->keys = calloc(index->tableSize, sizeof(uint64_t));
+    index->starts = malloc(sizeof(uint32_t) * index->tableSize);
+    index->counts = malloc(sizeof(uint32_t) * index->tableSize);
+
+    // Insert each run of equal keys into the hash table.
+    size_t start = 0;
+    while (start < numEntries) {
+	size_t end = start;
+	while (end < numEntries && entries[end].key == entries[start].key) {
+	    end++;
+	}
+	uint32_t slot = key_slot(index, entries[start].key);
+	while (index->keys[slot] != KEY_EMPTY) {
+	    slot = (slot + 1) & (index->tableSize - 1);
+	}
+	index->keys[slot] = entries[start].key;
+	index->starts[slot] = start;
+	index->counts[slot] = end - start;
+	start = end;
+    }
+    free(entries);
+    return index;
+}
+
+/* deletion_index_lookup()
+ * -----------------------
+ * Finds the words which turn into the given word, with one letter left out,
+ * 	when one of their own letters is deleted.
+ *
+ * index: the deletion index.
+ * word: the upper-case word.
+ * skip: the position of the letter of word to leave out, or -1 to look up
+ * 	the whole word.
+ * count: a pointer to store the number of postings found.
+ *
+ * Returns: the postings (word references whose position is the deleted
+ * 	letter), or NULL if there are none.
+ */
+const uint32_t* deletion_index_lookup(const DeletionIndex* index,
+	const char* word, int skip, int* count) {
+    uint64_t key = deletion_key(word, strlen(word), skip);
+    uint32_t slot = key_slot(index, key);
+    while (index->keys[slot] != KEY_EMPTY) {
+	if (index->keys[slot] == key) {
+	    *count = index->counts[slot];
+	    return index->postings + index->starts[slot];
+	}
+	slot = (slot + 1) & (index->tableSize - 1);
+    }
+    *count = 0;
+    return NULL;
+}
+
+/* deletion_index_neighbours()
+ * ---------------------------
+ * Finds every word which is one letter added, removed or changed away from
+ * 	the given word.
+ *
+ * index: the deletion index.
+ * word: the upper-case word to find neighbours of. It does not need to be
+ * 	in the dictionary.
+ * neighbours: an array of at least DELETION_MAX_NEIGHBOURS elements to
+ * 	store the neighbours in.
+ *
+ * Returns: the number of neighbours found. They are stored as word
+ * 	references with position 0, sorted by length then file order.
+ */
+int deletion_index_neighbours(const DeletionIndex* index, const char* word,
+	uint32_t* neighbours) {
+    int length = strlen(word);
+    Dictionary** dictionaries = index->dictionaries;
+    int numFound = 0;
+    int count;
+    const uint32_t* postings;
+    char shorter[WORD_BUFFER];
+
+    for (int i = 0; i < length; i++) {
+	// Changing letter i: same-length words which share deletion i.
+	postings = deletion_index_lookup(index, word, i, &count);
+	for (int p = 0; p < count; p++) {
+	    int id = DELETION_REF_ID(postings[p]);
+	    if (DELETION_REF_POSITION(postings[p]) == i &&
+		    dictionary_word(dictionaries[length], id)[i] != word[i]) {
+		neighbours[numFound++] = DELETION_REF(length, 0,
+			dictionary_file_position(dictionaries[length], id));
+	    }
+	}
+	// Removing letter i.
+	if (length - 1 >= index->minLength) {
+	    memcpy(shorter, word, i);
+	    strcpy(shorter + i, word + i + 1);
+	    int id = dictionary_find(dictionaries[length - 1], shorter);
+	    if (id != DICT_NOT_FOUND) {
+		neighbours[numFound++] = DELETION_REF(length - 1, 0,
+			dictionary_file_position(dictionaries[length - 1], id));
+	    }
+	}
+    }
+    // Adding a letter: longer words which have this word as a deletion.
+    if (length + 1 <= index->maxLength) {
+	postings = deletion_index_lookup(index, word, -1, &count);
+	for (int p = 0; p < count; p++) {
+	    neighbours[numFound++] = DELETION_REF(length + 1, 0,
+		    dictionary_file_position(dictionaries[length + 1],
+		    DELETION_REF_ID(postings[p])));
+	}
+    }
+
+    // Neighbours were gathered by file position so they sort into file
+    // order. Deleting either of a doubled letter gives the same word, so
+    // remove duplicates, then turn the positions back into ids.
+    qsort(neighbours, numFound, sizeof(uint32_t), compare_refs);
+    int numUnique = 0;
+    for (int i = 0; i < numFound; i++) {
+	if (numUnique == 0 || neighbours[i] != neighbours[numUnique - 1]) {
+	    neighbours[numUnique++] = neighbours[i];
+	}
+    }
+    for (int i = 0; i < numUnique; i++) {
+	int wordLength = DELETION_REF_LENGTH(neighbours[i]);
+	neighbours[i] = DELETION_REF(wordLength, 0, dictionary_file_id(
+		dictionaries[wordLength], DELETION_REF_ID(neighbours[i])));
+    }
+    return numUnique;
+}
+
+/* is_one_edit()
+ * -------------
+ * Checks if two words are one letter added, removed or changed apart.
+ *
+ * firstWord: the first word to compare.
+ * secondWord: the second word to compare.
+ *
+ * Returns: true if exactly one edit turns firstWord into secondWord.
+ */
+bool is_one_edit(const char* firstWord, const char* secondWord) {
+    int firstLength = strlen(firstWord);
+    int secondLength = strlen(secondWord);
+    if (firstLength == secondLength) {
+	int numOfDiff = 0;
+	for (int i = 0; i < firstLength; i++) {
+	    numOfDiff += firstWord[i] != secondWord[i];
+	}
+	return numOfDiff == 1;
+    }
+    // Make firstWord the longer word, which must be secondWord with one
+    // letter inserted.
+    if (firstLength < secondLength) {
+	const char* temp = firstWord;
+	firstWord = secondWord;
+	secondWord = temp;
+	firstLength = secondLength;
+	secondLength = strlen(secondWord);
+    }
+    if (firstLength != secondLength + 1) {
+	return false;
+    }
+    int i = 0;
+    while (i < secondLength && firstWord[i] == secondWord[i]) {
+	i++;
+    }
+    return strcmp(firstWord + i + 1, secondWord + i) == 0;
+}
+
+/* deletion_index_free()
+ * ---------------------
+ * Frees a deletion index (but not the dictionaries it refers to).
+ *
+ * index: the index to free.
+ */
+void deletion_index_free(DeletionIndex* index) {
+    free(index->keys);
+    free(index->starts);
+    free(index->counts);
+    free(index->postings);
+    free(index);
+}
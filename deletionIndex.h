@@ -0,0 +1,51 @@
+/*
+ * CSSE2310 A1
+ * UQWordLadder
+ * Deletion-neighbourhood index for ladders which may add or remove letters.
+ */
+
+#ifndef DELETION_INDEX_H
+#define DELETION_INDEX_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "dictionary.h"
+
+#define DELETION_MAX_NEIGHBOURS 512
+
+// A word reference packs the word's length, the position of the deleted
+// letter (for postings) and the word's id within its length's dictionary.
+#define DELETION_REF(length, position, id) (((uint32_t)(length) << 28) | \
+	((uint32_t)(position) << 24) | (uint32_t)(id))
+#define DELETION_REF_LENGTH(ref) ((int)((ref) >> 28))
+#define DELETION_REF_POSITION(ref) ((int)(((ref) >> 24) & 0xF))
+#define DELETION_REF_ID(ref) ((int)((ref) & 0xFFFFFF))
+
+/* DeletionIndex
+ * -------------
+ * Maps every single-letter deletion of every word (of all loaded lengths)
+ * to the words it came from, SymSpell style. Postings with equal keys are
+ * stored contiguously and an open-addressed hash table maps each key to its
+ * run of postings.
+ */
+typedef struct {
+    Dictionary** dictionaries;
+    int minLength;
+    int maxLength;
+    uint32_t tableSize;
+    uint64_t* keys;
+    uint32_t* starts;
+    uint32_t* counts;
+    uint32_t* postings;
+} DeletionIndex;
+
+DeletionIndex* deletion_index_build(Dictionary** dictionaries, int minLength,
+	int maxLength);
+const uint32_t* deletion_index_lookup(const DeletionIndex* index,
+	const char* word, int skip, int* count);
+int deletion_index_neighbours(const DeletionIndex* index, const char* word,
+	uint32_t* neighbours);
+bool is_one_edit(const char* firstWord, const char* secondWord);
+void deletion_index_free(DeletionIndex* index);
+
+#endif
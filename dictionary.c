@@ -0,0 +1,322 @@
+/*
+ * CSSE2310 A1
+ * UQWordLadder
+ * Packed, sorted and deduplicated dictionary of fixed-length words.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include "dictionary.h"
+
+#define RADIX_BITS 8
+#define RADIX_SIZE (1 << RADIX_BITS)
+#define NO_RANK UINT32_MAX
+
+/* section_size()
+ * --------------
+ * Returns: the number of bytes used by an optional section of a block, or 0
+ * 	if the block does not have it.
+ */
+static size_t section_size(int numWords, int sections, int section) {
+    switch (sections & section) {
+	case DICT_RANK_IDS:
+	    return (size_t)numWords * sizeof(uint32_t);
+	case DICT_FILE_ORDER:
+	    return (size_t)numWords * 2 * sizeof(uint32_t);
+	default:
+	    return 0;
+    }
+}
+
+/* dictionary_block_size()
+ * -----------------------
+ * Works out how large the packed block of a dictionary needs to be.
+ *
+ * length: the length of every word.
+ * numWords: the number of words in the dictionary.
+ * sections: the optional sections of the block (DICT_RANK_IDS and/or
+ * 	DICT_FILE_ORDER).
+ *
+ * Returns: the size of the block in bytes.
+ */
+size_t dictionary_block_size(int length, int numWords, int sections) {
+    return (size_t)numWords * sizeof(uint64_t) +
+	    section_size(numWords, sections, DICT_RANK_IDS) +
+	    section_size(numWords, sections, DICT_FILE_ORDER) +
+	    (size_t)numWords * (length + 1);
+}
+
+/* dictionary_from_block()
+ * -----------------------
+ * Wraps an already packed block (e.g. one mapped from shared memory) in a
+ * 	dictionary.
+ *
+ * block: the packed block.
+ * blockSize: the size of block in bytes.
+ * length: the length of every word.
+ * numWords: the number of words in block.
+ * sections: the optional sections block has.
+ * isShared: true if block is a shared-memory mapping, false if it was
+ * 	allocated with malloc().
+ *
+ * Returns: a pointer to the new dictionary, which owns block.
+ */
+Dictionary* dictionary_from_block(void* block, size_t blockSize, int length,
+	int numWords, int sections, bool isShared) {
+    Dictionary* dict = malloc(sizeof(Dictionary));
+    dict->length = length;
+    dict->stride = length + 1;
+    dict->numWords = numWords;
+    dict->sections = sections;
+    dict->keys = block;
+    const uint32_t* next = (const uint32_t*)(dict->keys + numWords);
+    dict->rankIds = NULL;
+    if (sections & DICT_RANK_IDS) {
+	dict->rankIds = next;
+	next += numWords;
+    }
+    dict->fileOrder = NULL;
+    dict->filePosition = NULL;
+    if (sections & DICT_FILE_ORDER) {
+	dict->fileOrder = next;
+	dict->filePosition = next + numWords;
+	next += 2 * numWords;
+    }
+    dict->words = (const char*)next;
+    dict->block = block;
+    dict->blockSize = blockSize;
+    dict->isShared = isShared;
+    return dict;
+}
+
+/* radix_sort()
+ * ------------
+ * Sorts keys, along with the file index of each, by least significant
+ * 	digit radix sort. Each pass is stable, so copies of the same key stay
+ * 	in file order.
+ *
+ * keys: the keys to sort.
+ * indices: the file index of each key, moved along with it.
+ * numKeys: the number of keys.
+ * keyBits: the number of significant bits in the keys.
+ */
+static void radix_sort(uint64_t* keys, uint32_t* indices, int numKeys,
+	int keyBits) {
+    uint64_t* keysOut = malloc(sizeof(uint64_t) * (numKeys + 1));
+    uint32_t* indicesOut = malloc(sizeof(uint32_t) * (numKeys + 1));
+    uint64_t* keysIn = keys;
+    uint32_t* indicesIn = indices;
+    for (int shift = 0; shift < keyBits; shift += RADIX_BITS) {
+	uint32_t counts[RADIX_SIZE + 1] = {0};
+	for (int i = 0; i < numKeys; i++) {
+	    counts[((keysIn[i] >> shift) & (RADIX_SIZE - 1)) + 1]++;
+	}
+	for (int digit = 0; digit < RADIX_SIZE; digit++) {
+	    counts[digit + 1] += counts[digit];
+	}
+	for (int i = 0; i < numKeys; i++) {
+	    uint32_t to = counts[(keysIn[i] >> shift) & (RADIX_SIZE - 1)]++;
+	    keysOut[to] = keysIn[i];
+	    indicesOut[to] = indicesIn[i];
+	}
+	uint64_t* keysSwap = keysIn;
+	keysIn = keysOut;
+	keysOut = keysSwap;
+	uint32_t* indicesSwap = indicesIn;
+	indicesIn = indicesOut;
+	indicesOut = indicesSwap;
+    }
+    // After an odd number of passes the result is in the scratch arrays.
+    if (keysIn != keys) {
+	memcpy(keys, keysIn, sizeof(uint64_t) * numKeys);
+	memcpy(indices, indicesIn, sizeof(uint32_t) * numKeys);
+	keysOut = keysIn;
+	indicesOut = indicesIn;
+    }
+    free(keysOut);
+    free(indicesOut);
+}
+
+/* dictionary_build()
+ * ------------------
+ * Packs a list of words into a new dictionary. Each word is packed into an
+ * 	integer key, the keys are radix sorted and copies of a word (e.g.
+ * 	"Ada" and "ada" once capitalised) are dropped in one pass over them.
+ *
+ * words: an array of arrays of upper-case words, all of the given length.
+ * numWords: the number of words in words.
+ * length: the length of every word.
+ *
+ * Returns: a pointer to the new dictionary, with ids in alphabetical order.
+ * 	The words are copied, so the caller still owns words.
+ */
+Dictionary* dictionary_build(char** words, int numWords, int length) {
+    uint64_t* keys = malloc(sizeof(uint64_t) * (numWords + 1));
+    uint32_t* indices = malloc(sizeof(uint32_t) * (numWords + 1));
+    for (int i = 0; i < numWords; i++) {
+	keys[i] = dictionary_key(words[i], length);
+	indices[i] = i;
+    }
+    radix_sort(keys, indices, numWords, length * DICT_LETTER_BITS);
+
+    // Keep the first copy of each key, which is the one first in the file.
+    uint32_t* rankOf = malloc(sizeof(uint32_t) * (numWords + 1));
+    int numUnique = 0;
+    for (int i = 0; i < numWords; i++) {
+	rankOf[indices[i]] = NO_RANK;
+	if (i == 0 || keys[i] != keys[i - 1]) {
+	    keys[numUnique] = keys[i];
+	    indices[numUnique] = indices[i];
+	    rankOf[indices[i]] = numUnique++;
+	}
+    }
+    // Number the distinct words by where they first appear in the file.
+    uint32_t* fileOrder = malloc(sizeof(uint32_t) * (numUnique + 1));
+    int position = 0;
+    bool sorted = true;
+    for (int i = 0; i < numWords; i++) {
+	if (rankOf[i] != NO_RANK) {
+	    sorted = sorted && rankOf[i] == (uint32_t)position;
+	    fileOrder[position++] = rankOf[i];
+	}
+    }
+
+    int sections = sorted ? 0 : DICT_FILE_ORDER;
+    size_t blockSize = dictionary_block_size(length, numUnique, sections);
+    void* block = malloc(blockSize + 1);
+    Dictionary* dict = dictionary_from_block(block, blockSize, length,
+	    numUnique, sections, false);
+    memcpy(block, keys, sizeof(uint64_t) * numUnique);
+    char* packed = (char*)dict->words;
+    for (int rank = 0; rank < numUnique; rank++) {
+	memcpy(packed + (size_t)rank * dict->stride, words[indices[rank]],
+		length + 1);
+    }
+    if (!sorted) {
+	uint32_t* order = (uint32_t*)dict->fileOrder;
+	uint32_t* positions = (uint32_t*)dict->filePosition;
+	for (int p = 0; p < numUnique; p++) {
+	    order[p] = fileOrder[p];
+	    positions[fileOrder[p]] = p;
+	}
+    }
+    free(fileOrder);
+    free(rankOf);
+    free(indices);
+    free(keys);
+    return dict;
+}
+
+/* dictionary_reorder()
+ * --------------------
+ * Makes a copy of a dictionary with its words in a different order. The
+ * 	copy maps each key to its word's new id and remembers the file order
+ * 	of the words.
+ *
+ * dict: the dictionary to copy.
+ * order: an array of numWords ids, where order[i] is the id in dict of the
+ * 	word which gets id i in the copy.
+ *
+ * Returns: a pointer to the reordered dictionary, which lives on the heap
+ * 	even if dict is shared.
+ */
+Dictionary* dictionary_reorder(const Dictionary* dict, const uint32_t* order) {
+    int numWords = dict->numWords;
+    int sections = DICT_RANK_IDS | DICT_FILE_ORDER;
+    size_t blockSize = dictionary_block_size(dict->length, numWords,
+	    sections);
+    void* block = malloc(blockSize + 1);
+    Dictionary* reordered = dictionary_from_block(block, blockSize,
+	    dict->length, numWords, sections, false);
+    memcpy(block, dict->keys, sizeof(uint64_t) * numWords);
+
+    uint32_t* newIds = malloc(sizeof(uint32_t) * (numWords + 1));
+    char* packed = (char*)reordered->words;
+    uint32_t* fileOrder = (uint32_t*)reordered->fileOrder;
+    uint32_t* filePosition = (uint32_t*)reordered->filePosition;
+    for (int i = 0; i < numWords; i++) {
+	newIds[order[i]] = i;
+	memcpy(packed + (size_t)i * dict->stride,
+		dictionary_word(dict, order[i]), dict->stride);
+	uint32_t position = dictionary_file_position(dict, order[i]);
+	filePosition[i] = position;
+	fileOrder[position] = i;
+    }
+    uint32_t* rankIds = (uint32_t*)reordered->rankIds;
+    for (int rank = 0; rank < numWords; rank++) {
+	rankIds[rank] = newIds[dict->rankIds ? dict->rankIds[rank] : rank];
+    }
+    free(newIds);
+    return reordered;
+}
+
+/* dictionary_find()
+ * -----------------
+ * Looks up a word in the dictionary by binary search of the keys.
+ *
+ * dict: the dictionary to search.
+ * word: the word to look for.
+ *
+ * Returns: the id of the word, or DICT_NOT_FOUND if it is not in the
+ * 	dictionary or has the wrong length.
+ */
+int dictionary_find(const Dictionary* dict, const char* word) {
+    if (strlen(word) != dict->length || dict->numWords == 0) {
+	return DICT_NOT_FOUND;
+    }
+    uint64_t key = dictionary_key(word, dict->length);
+    const uint64_t* base = dict->keys;
+    int remaining = dict->numWords;
+    // The probe only picks which half to keep, which compiles to a
+    // conditional move rather than a hard to predict branch.
+    while (remaining > 1) {
+	int half = remaining / 2;
+	base = base[half] <= key ? base + half : base;
+	remaining -= half;
+    }
+    if (*base != key) {
+	return DICT_NOT_FOUND;
+    }
+    int rank = base - dict->keys;
+    int id = dict->rankIds ? (int)dict->rankIds[rank] : rank;
+    // Keys only pack letters, so make sure it really is the same word.
+    if (memcmp(dictionary_word(dict, id), word, dict->length) != 0) {
+	return DICT_NOT_FOUND;
+    }
+    return id;
+}
+
+/* dictionary_key()
+ * ----------------
+ * Packs an upper-case word into an integer, five bits per letter with the
+ * 	first letter in the most significant position. Letters are stored as
+ * 	1 to 26, so keys of words with equal lengths sort alphabetically.
+ *
+ * word: the word to pack.
+ * length: the number of letters in word (at most 12).
+ *
+ * Returns: the packed key.
+ */
+uint64_t dictionary_key(const char* word, int length) {
+    uint64_t key = 0;
+    for (int i = 0; i < length; i++) {
+	key = (key << DICT_LETTER_BITS) | ((word[i] - 'A' + 1) & 0x1F);
+    }
+    return key;
+}
+
+/* dictionary_free()
+ * -----------------
+ * Frees a dictionary and unmaps or frees its block.
+ *
+ * dict: the dictionary to free.
+ */
+void dictionary_free(Dictionary* dict) {
+    if (dict->isShared) {
+	munmap(dict->block, dict->blockSize);
+    } else {
+	free(dict->block);
+    }
+    free(dict);
+}
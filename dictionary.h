@@ -0,0 +1,91 @@
+/*
+ * CSSE2310 A1
+ * UQWordLadder
+ * Packed, sorted and deduplicated dictionary of fixed-length words.
+ */
+
+#ifndef DICTIONARY_H
+#define DICTIONARY_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define DICT_NOT_FOUND (-1)
+#define DICT_LETTER_BITS 5
+
+// Optional sections of a dictionary block.
+#define DICT_RANK_IDS 1
+#define DICT_FILE_ORDER 2
+
+/* Dictionary
+ * ----------
+ * A read-only table of distinct words which all have the same length.
+ *
+ * Everything lives in one contiguous block so that the whole dictionary can
+ * be copied into (or mapped from) a shared-memory segment without any
+ * pointer fix-ups:
+ *
+ * 	[numWords * uint64_t keys (see dictionary_key()), sorted]
+ * 	[numWords * uint32_t ids of the words in key order, if DICT_RANK_IDS]
+ * 	[2 * numWords * uint32_t file order and positions, if DICT_FILE_ORDER]
+ * 	[numWords * stride bytes of NUL-terminated words]
+ *
+ * Words are normally in key (i.e. alphabetical) order and are looked up by
+ * binary search of the keys. A dictionary which has been reordered (e.g.
+ * for locality) maps each key to its word's id. Unless the file was already
+ * sorted, the order words first appeared in the file is kept so that
+ * output can still be listed in it.
+ */
+typedef struct {
+    int length;
+    int stride;
+    int numWords;
+    int sections;
+    const uint64_t* keys;
+    // Id of the word with each key if ids are not in key order, else NULL.
+    const uint32_t* rankIds;
+    // File order of the words if it differs from id order, otherwise NULL.
+    const uint32_t* fileOrder;
+    const uint32_t* filePosition;
+    const char* words;
+    // Backing storage of all of the above.
+    void* block;
+    size_t blockSize;
+    bool isShared;
+} Dictionary;
+
+size_t dictionary_block_size(int length, int numWords, int sections);
+Dictionary* dictionary_build(char** words, int numWords, int length);
+Dictionary* dictionary_from_block(void* block, size_t blockSize, int length,
+	int numWords, int sections, bool isShared);
+Dictionary* dictionary_reorder(const Dictionary* dict, const uint32_t* order);
+int dictionary_find(const Dictionary* dict, const char* word);
+uint64_t dictionary_key(const char* word, int length);
+void dictionary_free(Dictionary* dict);
+
+/* dictionary_word()
+ * -----------------
+ * Returns: the word with the given id (0 to numWords - 1).
+ */
+static inline const char* dictionary_word(const Dictionary* dict, int id) {
+    return dict->words + (size_t)id * dict->stride;
+}
+
+/* dictionary_file_id()
+ * --------------------
+ * Returns: the id of the word at the given position of the dictionary file.
+ */
+static inline int dictionary_file_id(const Dictionary* dict, int position) {
+    return dict->fileOrder ? (int)dict->fileOrder[position] : position;
+}
+
+/* dictionary_file_position()
+ * --------------------------
+ * Returns: the position in the dictionary file of the word with the given id.
+ */
+static inline int dictionary_file_position(const Dictionary* dict, int id) {
+    return dict->filePosition ? (int)dict->filePosition[id] : id;
+}
+
+#endif
@@ -0,0 +1,29 @@
+/*
+ * CSSE2310 A1
+ * UQWordLadder
+ * Millisecond timing of work on the monotonic clock.
+ */
+
+#include "elapsed.h"
+
+#define NSEC_PER_MSEC 1e6
+#define MSEC_PER_SEC 1e3
+
+/* elapsed_msec()
+ * --------------
+ * Measures the time since a point read with
+ * 	clock_gettime(CLOCK_MONOTONIC, start).
+ *
+ * start: the time to measure from, which is reset to now (so consecutive
+ * 	calls time consecutive pieces of work).
+ *
+ * Returns: the milliseconds since start.
+ */
+double elapsed_msec(struct timespec* start) {
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double msec = (end.tv_sec - start->tv_sec) * MSEC_PER_SEC +
+	    (end.tv_nsec - start->tv_nsec) / NSEC_PER_MSEC;
+    *start = end;
+    return msec;
+}
@@ -0,0 +1,14 @@
+/*
+ * CSSE2310 A1
+ * UQWordLadder
+ * Millisecond timing of work on the monotonic clock.
+ */
+
+#ifndef ELAPSED_H
+#define ELAPSED_H
+
+#include <time.h>
+
+double elapsed_msec(struct timespec* start);
+
+#endif
@@ -0,0 +1,892 @@
+/*
+ * CSSE2310 A1
+ * UQWordLadder
+ * Persistent, editable index of the words of one length and their
+ * one-letter adjacency.
+ *
+ * The file is mapped shared, so edits update it in place:
+ *
+ * 	[IndexHeader]
+ * 	[slotCapacity * stride bytes of words, empty slots start with '\0']
+ * 	[slotCapacity * AdjacencyHead]
+ * 	[tableSize * uint32_t open-addressed hash slots holding slot + 1]
+ * 	[edgeCapacity * uint32_t neighbour slots]
+ *
+ * Adding or removing a word only touches the word's own slot, its hash
+ * entry and the adjacency runs of its neighbours. When a run is full it
+ * moves to the top of the edge area with twice the room. Only when the
+ * slots or the edge area run out is the file compacted into a bigger one.
+ *
+ * Editors hold an exclusive flock() on the file from opening to closing and
+ * readers a shared one, so a game never sees half-applied edits. New files
+ * are written under a temporary name and renamed into place, so a process
+ * which gets the lock has to check that the file was not replaced first.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "ladderIndex.h"
+#include "lexicon.h"
+
+#define INDEX_MAGIC "UQWLINDX"
+#define INDEX_MAGIC_SIZE 8
+// Bump whenever the file layout changes.
+#define INDEX_VERSION 1
+#define TABLE_EMPTY 0
+#define NO_SLOT UINT32_MAX
+#define MIN_EDGE_RUN 4
+#define SLOT_SLACK 64
+#define EDGE_SLACK 1024
+#define LETTERS 26
+#define MAX_INDEX_NEIGHBOURS 256
+#define MAX_REPORTED_PROBLEMS 10
+#define FNV_OFFSET 2166136261u
+#define FNV_PRIME 16777619u
+#define TEMP_SUFFIX ".XXXXXX"
+#define INDEX_MODE 0644
+
+struct IndexHeader {
+    char magic[INDEX_MAGIC_SIZE];
+    uint32_t version;
+    // Non-zero while edits are being applied, so a crash is detected.
+    uint32_t dirty;
+    int32_t length;
+    uint32_t slotCapacity;
+    uint32_t numSlots;
+    uint32_t numWords;
+    uint32_t tableSize;
+    uint32_t edgeCapacity;
+    uint32_t edgeUsed;
+    uint32_t reserved;
+};
+
+struct AdjacencyHead {
+    uint32_t offset;
+    uint16_t count;
+    uint16_t capacity;
+};
+
+/* Byte offsets of the sections of an index file. */
+typedef struct {
+    size_t words;
+    size_t heads;
+    size_t table;
+    size_t edges;
+    size_t total;
+} Layout;
+
+/* align8()
+ * --------
+ * Returns: size rounded up to a multiple of 8 bytes.
+ */
+static size_t align8(size_t size) {
+    return (size + 7) & ~(size_t)7;
+}
+
+/* index_layout()
+ * --------------
+ * Works out where each section of an index file starts.
+ *
+ * length: the length of every word.
+ * slotCapacity: the number of word slots.
+ * tableSize: the number of hash slots.
+ * edgeCapacity: the number of entries in the edge area.
+ *
+ * Returns: the layout of the file.
+ */
+static Layout index_layout(int length, uint32_t slotCapacity,
+	uint32_t tableSize, uint32_t edgeCapacity) {
+    Layout layout;
+    layout.words = align8(sizeof(IndexHeader));
+    layout.heads = layout.words + align8((size_t)slotCapacity *
+	    (length + 1));
+    layout.table = layout.heads + (size_t)slotCapacity *
+	    sizeof(AdjacencyHead);
+    layout.edges = layout.table + align8((size_t)tableSize *
+	    sizeof(uint32_t));
+    layout.total = layout.edges + (size_t)edgeCapacity * sizeof(uint32_t);
+    return layout;
+}
+
+/* table_size_for()
+ * ----------------
+ * Returns: the number of hash slots for the given number of word slots (a
+ * 	power of two at least twice as big).
+ */
+static uint32_t table_size_for(uint32_t slotCapacity) {
+    uint32_t size = 2;
+    while (size < slotCapacity * 2) {
+	size <<= 1;
+    }
+    return size;
+}
+
+/* map_sections()
+ * --------------
+ * Points the section pointers of an index at its mapping.
+ *
+ * index: the index, whose map and header have been set.
+ */
+static void map_sections(LadderIndex* index) {
+    IndexHeader* header = index->header;
+    Layout layout = index_layout(header->length, header->slotCapacity,
+	    header->tableSize, header->edgeCapacity);
+    index->words = index->map + layout.words;
+    index->heads = (AdjacencyHead*)(index->map + layout.heads);
+    index->table = (uint32_t*)(index->map + layout.table);
+    index->edges = (uint32_t*)(index->map + layout.edges);
+}
+
+/* slot_word()
+ * -----------
+ * Returns: the word in a slot, which is empty if the word was removed.
+ */
+static char* slot_word(const LadderIndex* index, uint32_t slot) {
+    return index->words + (size_t)slot * (index->header->length + 1);
+}
+
+/* home_slot()
+ * -----------
+ * Returns: the first hash slot to probe for word, from its 32-bit FNV-1a
+ * 	hash.
+ */
+static uint32_t home_slot(const LadderIndex* index, const char* word) {
+    uint32_t hash = FNV_OFFSET;
+    for (int i = 0; i < index->header->length; i++) {
+	hash ^= (unsigned char)word[i];
+	hash *= FNV_PRIME;
+    }
+    return hash & (index->header->tableSize - 1);
+}
+
+/* find_entry()
+ * ------------
+ * Returns: the hash slot holding word, or NO_SLOT if word is not indexed.
+ */
+static uint32_t find_entry(const LadderIndex* index, const char* word) {
+    uint32_t mask = index->header->tableSize - 1;
+    for (uint32_t i = home_slot(index, word);
+	    index->table[i] != TABLE_EMPTY; i = (i + 1) & mask) {
+	if (strcmp(slot_word(index, index->table[i] - 1), word) == 0) {
+	    return i;
+	}
+    }
+    return NO_SLOT;
+}
+
+/* find_slot()
+ * -----------
+ * Returns: the word slot holding word, or NO_SLOT if word is not indexed.
+ */
+static uint32_t find_slot(const LadderIndex* index, const char* word) {
+    uint32_t entry = find_entry(index, word);
+    return entry == NO_SLOT ? NO_SLOT : index->table[entry] - 1;
+}
+
+/* insert_entry()
+ * --------------
+ * Adds a word slot to the hash table.
+ */
+static void insert_entry(LadderIndex* index, uint32_t slot) {
+    uint32_t mask = index->header->tableSize - 1;
+    uint32_t i = home_slot(index, slot_word(index, slot));
+    while (index->table[i] != TABLE_EMPTY) {
+	i = (i + 1) & mask;
+    }
+    index->table[i] = slot + 1;
+}
+
+/* delete_entry()
+ * --------------
+ * Removes a hash table entry, shifting later entries of the probe sequence
+ * 	back so that no tombstone is needed.
+ *
+ * index: the index.
+ * hole: the hash slot to empty.
+ */
+static void delete_entry(LadderIndex* index, uint32_t hole) {
+    uint32_t mask = index->header->tableSize - 1;
+    uint32_t next = hole;
+    while (true) {
+	next = (next + 1) & mask;
+	if (index->table[next] == TABLE_EMPTY) {
+	    break;
+	}
+	uint32_t home = home_slot(index, slot_word(index,
+		index->table[next] - 1));
+	// The entry may move into the hole unless its home lies cyclically
+	// in (hole, next].
+	bool stays = hole <= next ? (home > hole && home <= next) :
+		(home > hole || home <= next);
+	if (!stays) {
+	    index->table[hole] = index->table[next];
+	    hole = next;
+	}
+    }
+    index->table[hole] = TABLE_EMPTY;
+}
+
+/* write_index_file()
+ * ------------------
+ * Writes a new, compacted index file and atomically moves it into place.
+ * 	Slots follow the file order of the dictionary.
+ *
+ * path: the path of the index file.
+ * dict: the words to index.
+ * graph: the one-letter graph of dict.
+ * slotCapacity: the number of word slots (at least dict->numWords).
+ * edgeCapacity: the size of the edge area (at least the number of edges).
+ * dirty: the value of the dirty flag of the new file.
+ * lockedFd: a pointer to store a descriptor of the new file in, which is
+ * 	locked exclusively before the file is moved into place, or NULL to
+ * 	close the file.
+ *
+ * Returns: true if the file was written.
+ */
+static bool write_index_file(const char* path, const Dictionary* dict,
+	const WordGraph* graph, uint32_t slotCapacity, uint32_t edgeCapacity,
+	uint32_t dirty, int* lockedFd) {
+    uint32_t tableSize = table_size_for(slotCapacity);
+    Layout layout = index_layout(dict->length, slotCapacity, tableSize,
+	    edgeCapacity);
+    // A unique name, as several processes may rebuild the same index.
+    char* tempPath = malloc(strlen(path) + sizeof(TEMP_SUFFIX));
+    strcpy(tempPath, path);
+    strcat(tempPath, TEMP_SUFFIX);
+    int fd = mkstemp(tempPath);
+    char* map = MAP_FAILED;
+    if (fd >= 0 && fchmod(fd, INDEX_MODE) == 0 &&
+	    ftruncate(fd, layout.total) == 0) {
+	map = mmap(NULL, layout.total, PROT_READ | PROT_WRITE, MAP_SHARED,
+		fd, 0);
+    }
+    if (map == MAP_FAILED) {
+	if (fd >= 0) {
+	    close(fd);
+	    unlink(tempPath);
+	}
+	free(tempPath);
+	return false;
+    }
+
+    LadderIndex index;
+    index.map = map;
+    index.header = (IndexHeader*)map;
+    memcpy(index.header->magic, INDEX_MAGIC, INDEX_MAGIC_SIZE);
+    index.header->version = INDEX_VERSION;
+    index.header->dirty = dirty;
+    index.header->length = dict->length;
+    index.header->slotCapacity = slotCapacity;
+    index.header->numSlots = dict->numWords;
+    index.header->numWords = dict->numWords;
+    index.header->tableSize = tableSize;
+    index.header->edgeCapacity = edgeCapacity;
+    index.header->edgeUsed = graph->offsets[dict->numWords];
+    map_sections(&index);
+    uint32_t offset = 0;
+    for (int slot = 0; slot < dict->numWords; slot++) {
+	int id = dictionary_file_id(dict, slot);
+	const uint32_t* neighbours = graph->neighbours + graph->offsets[id];
+	strcpy(slot_word(&index, slot), dictionary_word(dict, id));
+	index.heads[slot].offset = offset;
+	index.heads[slot].count = word_graph_degree(graph, id);
+	index.heads[slot].capacity = index.heads[slot].count;
+	for (int j = 0; j < index.heads[slot].count; j++) {
+	    index.edges[offset++] = dictionary_file_position(dict,
+		    neighbours[j]);
+	}
+	insert_entry(&index, slot);
+    }
+
+    bool written = msync(map, layout.total, MS_SYNC) == 0;
+    munmap(map, layout.total);
+    if (lockedFd == NULL) {
+	written = close(fd) == 0 && written;
+    } else {
+	// Nobody else can open the file before it is renamed.
+	written = written && flock(fd, LOCK_EX) == 0;
+    }
+    written = written && rename(tempPath, path) == 0;
+    if (!written) {
+	unlink(tempPath);
+    }
+    if (lockedFd != NULL && written) {
+	*lockedFd = fd;
+    } else if (lockedFd != NULL) {
+	close(fd);
+    }
+    free(tempPath);
+    return written;
+}
+
+/* ladder_index_create()
+ * ---------------------
+ * Builds an index file from a list of words (dictionary_build() drops
+ * 	duplicates).
+ *
+ * path: the path of the index file to create (or replace).
+ * words: an array of arrays of upper-case words of the given length.
+ * numWords: the number of words in words.
+ * length: the length of every word.
+ *
+ * Returns: true if the file was written.
+ */
+bool ladder_index_create(const char* path, char** words, int numWords,
+	int length) {
+    Dictionary* dict = dictionary_build(words, numWords, length);
+    WordGraph* graph = word_graph_build(dict);
+    uint32_t numUnique = dict->numWords;
+    bool written = write_index_file(path, dict, graph,
+	    numUnique + numUnique / 2 + SLOT_SLACK,
+	    graph->offsets[numUnique] + graph->offsets[numUnique] / 2 +
+	    EDGE_SLACK, 0, NULL);
+    word_graph_free(graph);
+    dictionary_free(dict);
+    return written;
+}
+
+/* header_status()
+ * ---------------
+ * Returns: INDEX_OK if a mapped header belongs to an intact index of words
+ * 	of the given length which fills fileSize bytes, INDEX_DIRTY if it
+ * 	would but edits to it were interrupted, otherwise INDEX_INVALID.
+ */
+static IndexStatus header_status(const IndexHeader* header, int length,
+	off_t fileSize) {
+    if (memcmp(header->magic, INDEX_MAGIC, INDEX_MAGIC_SIZE) != 0 ||
+	    header->version != INDEX_VERSION || header->length != length ||
+	    header->numSlots > header->slotCapacity ||
+	    header->numWords > header->numSlots ||
+	    header->edgeUsed > header->edgeCapacity ||
+	    header->tableSize != table_size_for(header->slotCapacity)) {
+	return INDEX_INVALID;
+    }
+    Layout layout = index_layout(length, header->slotCapacity,
+	    header->tableSize, header->edgeCapacity);
+    if (layout.total != (size_t)fileSize) {
+	return INDEX_INVALID;
+    }
+    return header->dirty != 0 ? INDEX_DIRTY : INDEX_OK;
+}
+
+/* open_locked()
+ * -------------
+ * Opens and locks an index file. If the file was replaced while waiting
+ * 	for the lock, the new one is opened and locked instead.
+ *
+ * path: the path of the index file.
+ * writable: true to open the file for editing, with an exclusive lock.
+ *
+ * Returns: the locked file descriptor, or -1 if the file could not be
+ * 	opened or locked.
+ */
+static int open_locked(const char* path, bool writable) {
+    while (true) {
+	int fd = open(path, writable ? O_RDWR : O_RDONLY);
+	if (fd < 0) {
+	    return -1;
+	}
+	int locked;
+	do {
+	    locked = flock(fd, writable ? LOCK_EX : LOCK_SH);
+	} while (locked != 0 && errno == EINTR);
+	if (locked != 0) {
+	    close(fd);
+	    return -1;
+	}
+	struct stat opened, current;
+	if (fstat(fd, &opened) == 0 && stat(path, &current) == 0 &&
+		opened.st_dev == current.st_dev &&
+		opened.st_ino == current.st_ino) {
+	    return fd;
+	}
+	close(fd);
+    }
+}
+
+/* ladder_index_open()
+ * -------------------
+ * Maps an index file, holding a lock on it until ladder_index_close(): a
+ * 	shared lock to read it, or an exclusive one to edit it.
+ *
+ * path: the path of the index file.
+ * length: the length of words the index must hold.
+ * writable: true to map the file for editing.
+ * status: a pointer to store INDEX_OK, INDEX_MISSING if there is no file,
+ * 	INDEX_UNAVAILABLE if it could not be opened, locked or mapped,
+ * 	INDEX_DIRTY if it was left half-edited by a crash, or INDEX_INVALID
+ * 	if it is not an intact index of the given length.
+ *
+ * Returns: the index, or NULL if it could not be opened.
+ */
+LadderIndex* ladder_index_open(const char* path, int length, bool writable,
+	IndexStatus* status) {
+    int fd = open_locked(path, writable);
+    if (fd < 0) {
+	*status = access(path, F_OK) == 0 ? INDEX_UNAVAILABLE : INDEX_MISSING;
+	return NULL;
+    }
+    struct stat file;
+    char* map = MAP_FAILED;
+    *status = INDEX_UNAVAILABLE;
+    if (fstat(fd, &file) == 0) {
+	*status = INDEX_INVALID;
+    }
+    if (*status == INDEX_INVALID &&
+	    file.st_size >= (off_t)sizeof(IndexHeader)) {
+	map = mmap(NULL, file.st_size, PROT_READ | (writable ? PROT_WRITE : 0),
+		MAP_SHARED, fd, 0);
+	*status = map == MAP_FAILED ? INDEX_UNAVAILABLE :
+		header_status((IndexHeader*)map, length, file.st_size);
+    }
+    if (*status != INDEX_OK) {
+	if (map != MAP_FAILED) {
+	    munmap(map, file.st_size);
+	}
+	close(fd);
+	return NULL;
+    }
+
+    LadderIndex* index = malloc(sizeof(LadderIndex));
+    index->path = strdup(path);
+    index->fd = fd;
+    index->writable = writable;
+    index->mapSize = file.st_size;
+    index->map = map;
+    index->header = (IndexHeader*)map;
+    map_sections(index);
+    return index;
+}
+
+/* ladder_index_dictionary()
+ * -------------------------
+ * Makes a dictionary of the indexed words, whose file order is the slot
+ * 	order, and converts the stored adjacency into a graph whose ids
+ * 	match it.
+ *
+ * index: the index.
+ * graph: a pointer to store the graph in.
+ *
+ * Returns: the dictionary, or NULL if the stored adjacency refers to slots
+ * 	which do not hold words or a word is indexed twice.
+ */
+Dictionary* ladder_index_dictionary(const LadderIndex* index,
+	WordGraph** graph) {
+    uint32_t numSlots = index->header->numSlots;
+    uint32_t* ids = malloc(sizeof(uint32_t) * (numSlots + 1));
+    char** words = malloc(sizeof(char*) * (numSlots + 1));
+    int numWords = 0;
+    size_t numEdges = 0;
+    for (uint32_t slot = 0; slot < numSlots; slot++) {
+	ids[slot] = NO_SLOT;
+	if (slot_word(index, slot)[0] != '\0') {
+	    ids[slot] = numWords;
+	    words[numWords++] = slot_word(index, slot);
+	    numEdges += index->heads[slot].count;
+	}
+    }
+
+    WordGraph* built = malloc(sizeof(WordGraph));
+    built->numWords = numWords;
+    built->offsets = malloc(sizeof(uint32_t) * (numWords + 1));
+    built->neighbours = malloc(sizeof(uint32_t) * (numEdges + 1));
+    built->offsets[0] = 0;
+    bool valid = true;
+    for (uint32_t slot = 0; slot < numSlots && valid; slot++) {
+	if (ids[slot] == NO_SLOT) {
+	    continue;
+	}
+	const AdjacencyHead* head = &index->heads[slot];
+	uint32_t* out = built->neighbours + built->offsets[ids[slot]];
+	valid = (size_t)head->offset + head->count <=
+		index->header->edgeCapacity;
+	for (int j = 0; valid && j < head->count; j++) {
+	    uint32_t neighbour = index->edges[head->offset + j];
+	    valid = neighbour < numSlots && ids[neighbour] != NO_SLOT;
+	    out[j] = valid ? ids[neighbour] : 0;
+	}
+	built->offsets[ids[slot] + 1] = built->offsets[ids[slot]] +
+		head->count;
+    }
+    free(ids);
+    Dictionary* dict = dictionary_build(words, numWords,
+	    index->header->length);
+    free(words);
+    if (!valid || dict->numWords != numWords) {
+	dictionary_free(dict);
+	word_graph_free(built);
+	return NULL;
+    }
+    // Renumber from slot order to dictionary ids (which also sorts the
+    // runs, as they are unordered on disk).
+    uint32_t* order = malloc(sizeof(uint32_t) * (numWords + 1));
+    for (int id = 0; id < numWords; id++) {
+	order[id] = dictionary_file_position(dict, id);
+    }
+    *graph = word_graph_permute(built, order);
+    free(order);
+    word_graph_free(built);
+    return dict;
+}
+
+/* grow_index()
+ * ------------
+ * Compacts the index into a new file with room for more slots and edges,
+ * 	and maps that instead, keeping it locked. Slots are renumbered.
+ *
+ * index: the index, which must be writable.
+ * extraSlots: the number of free slots needed.
+ * extraEdges: the number of free edge entries needed.
+ *
+ * Returns: true if the index grew.
+ */
+static bool grow_index(LadderIndex* index, uint32_t extraSlots,
+	uint32_t extraEdges) {
+    WordGraph* graph;
+    Dictionary* dict = ladder_index_dictionary(index, &graph);
+    if (dict == NULL) {
+	return false;
+    }
+    uint32_t numEdges = graph->offsets[dict->numWords];
+    uint32_t slotCapacity = (dict->numWords + extraSlots) * 2 + SLOT_SLACK;
+    uint32_t edgeCapacity = (numEdges + extraEdges) * 2 + EDGE_SLACK;
+    int fd;
+    bool written = write_index_file(index->path, dict, graph, slotCapacity,
+	    edgeCapacity, index->header->dirty, &fd);
+    word_graph_free(graph);
+    dictionary_free(dict);
+    if (!written) {
+	return false;
+    }
+
+    // The new file carries the dirty flag over, so it stays marked.
+    struct stat file;
+    char* map = MAP_FAILED;
+    if (fstat(fd, &file) == 0) {
+	map = mmap(NULL, file.st_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+		fd, 0);
+    }
+    if (map == MAP_FAILED) {
+	close(fd);
+	return false;
+    }
+    // Readers waiting for the old file find it replaced once it is closed.
+    munmap(index->map, index->mapSize);
+    close(index->fd);
+    index->fd = fd;
+    index->mapSize = file.st_size;
+    index->map = map;
+    index->header = (IndexHeader*)map;
+    map_sections(index);
+    return true;
+}
+
+/* run_growth()
+ * ------------
+ * Returns: the edge entries needed to add one neighbour to a slot's run.
+ */
+static uint32_t run_growth(const LadderIndex* index, uint32_t slot) {
+    const AdjacencyHead* head = &index->heads[slot];
+    if (head->count < head->capacity) {
+	return 0;
+    }
+    return head->capacity == 0 ? MIN_EDGE_RUN : head->capacity * 2;
+}
+
+/* append_edge()
+ * -------------
+ * Adds a neighbour to a slot's run, moving the run to the top of the edge
+ * 	area with twice the room if it is full. The caller must have made
+ * 	sure the edge area is big enough.
+ */
+static void append_edge(LadderIndex* index, uint32_t slot,
+	uint32_t neighbour) {
+    AdjacencyHead* head = &index->heads[slot];
+    uint32_t growth = run_growth(index, slot);
+    if (growth != 0) {
+	uint32_t offset = index->header->edgeUsed;
+	memmove(index->edges + offset, index->edges + head->offset,
+		sizeof(uint32_t) * head->count);
+	head->offset = offset;
+	head->capacity = growth;
+	index->header->edgeUsed += growth;
+    }
+    index->edges[head->offset + head->count++] = neighbour;
+}
+
+/* remove_edge()
+ * -------------
+ * Removes a neighbour from a slot's run (runs are unordered, so the last
+ * 	neighbour takes its place).
+ */
+static void remove_edge(LadderIndex* index, uint32_t slot,
+	uint32_t neighbour) {
+    AdjacencyHead* head = &index->heads[slot];
+    uint32_t* run = index->edges + head->offset;
+    for (int j = 0; j < head->count; j++) {
+	if (run[j] == neighbour) {
+	    run[j] = run[--head->count];
+	    return;
+	}
+    }
+}
+
+/* find_neighbours()
+ * -----------------
+ * Finds the indexed words one letter away from a word by probing every
+ * 	one-letter change of it.
+ *
+ * index: the index.
+ * word: the upper-case word.
+ * neighbours: an array of MAX_INDEX_NEIGHBOURS slots to fill in.
+ *
+ * Returns: the number of neighbours found.
+ */
+static int find_neighbours(const LadderIndex* index, const char* word,
+	uint32_t* neighbours) {
+    int length = index->header->length;
+    char changed[WORD_BUFFER];
+    strcpy(changed, word);
+    int numFound = 0;
+    for (int p = 0; p < length; p++) {
+	for (int c = 0; c < LETTERS; c++) {
+	    if ('A' + c == word[p]) {
+		continue;
+	    }
+	    changed[p] = 'A' + c;
+	    uint32_t slot = find_slot(index, changed);
+	    if (slot != NO_SLOT) {
+		neighbours[numFound++] = slot;
+	    }
+	}
+	changed[p] = word[p];
+    }
+    return numFound;
+}
+
+/* ladder_index_begin_edits()
+ * --------------------------
+ * Marks the index file as being edited, so that a crash part way through
+ * 	leaves a file which will be rejected rather than silently wrong.
+ *
+ * index: the writable index.
+ *
+ * Returns: true if the mark reached the file.
+ */
+bool ladder_index_begin_edits(LadderIndex* index) {
+    index->header->dirty = 1;
+    return msync(index->map, sizeof(IndexHeader), MS_SYNC) == 0;
+}
+
+/* ladder_index_end_edits()
+ * ------------------------
+ * Flushes edits to the index file and then clears the editing mark.
+ *
+ * index: the writable index.
+ */
+void ladder_index_end_edits(LadderIndex* index) {
+    msync(index->map, index->mapSize, MS_SYNC);
+    index->header->dirty = 0;
+    msync(index->map, sizeof(IndexHeader), MS_SYNC);
+}
+
+/* ladder_index_add()
+ * ------------------
+ * Adds a word to the index and links it with its neighbours. This costs a
+ * 	fixed number of probes plus time proportional to the neighbours'
+ * 	degrees, except when the file has to grow.
+ *
+ * index: the writable index.
+ * word: the upper-case word to add.
+ * added: a pointer to store whether the word was new.
+ *
+ * Returns: false if the index needed to grow and could not.
+ */
+bool ladder_index_add(LadderIndex* index, const char* word, bool* added) {
+    *added = false;
+    if (find_slot(index, word) != NO_SLOT) {
+	return true;
+    }
+    uint32_t neighbours[MAX_INDEX_NEIGHBOURS];
+    int numNeighbours = find_neighbours(index, word, neighbours);
+    uint32_t edgesNeeded = numNeighbours;
+    for (int i = 0; i < numNeighbours; i++) {
+	edgesNeeded += run_growth(index, neighbours[i]);
+    }
+    IndexHeader* header = index->header;
+    if (header->numSlots == header->slotCapacity ||
+	    header->edgeUsed + edgesNeeded > header->edgeCapacity) {
+	if (!grow_index(index, 1, edgesNeeded)) {
+	    return false;
+	}
+	// Growing renumbers slots.
+	header = index->header;
+	numNeighbours = find_neighbours(index, word, neighbours);
+    }
+
+    uint32_t slot = header->numSlots++;
+    strcpy(slot_word(index, slot), word);
+    insert_entry(index, slot);
+    header->numWords++;
+    AdjacencyHead* head = &index->heads[slot];
+    head->offset = header->edgeUsed;
+    head->count = 0;
+    head->capacity = numNeighbours;
+    header->edgeUsed += numNeighbours;
+    for (int i = 0; i < numNeighbours; i++) {
+	append_edge(index, slot, neighbours[i]);
+	append_edge(index, neighbours[i], slot);
+    }
+    *added = true;
+    return true;
+}
+
+/* ladder_index_remove()
+ * ---------------------
+ * Removes a word from the index and unlinks it from its neighbours, in time
+ * 	proportional to the neighbours' degrees. The slot stays empty until
+ * 	the file is next compacted.
+ *
+ * index: the writable index.
+ * word: the upper-case word to remove.
+ * removed: a pointer to store whether the word was indexed.
+ *
+ * Returns: true (removing never needs more room).
+ */
+bool ladder_index_remove(LadderIndex* index, const char* word,
+	bool* removed) {
+    uint32_t entry = find_entry(index, word);
+    *removed = entry != NO_SLOT;
+    if (entry == NO_SLOT) {
+	return true;
+    }
+    uint32_t slot = index->table[entry] - 1;
+    AdjacencyHead* head = &index->heads[slot];
+    for (int j = 0; j < head->count; j++) {
+	remove_edge(index, index->edges[head->offset + j], slot);
+    }
+    head->count = 0;
+    delete_entry(index, entry);
+    slot_word(index, slot)[0] = '\0';
+    index->header->numWords--;
+    return true;
+}
+
+/* ladder_index_num_words()
+ * ------------------------
+ * Returns: the number of words in the index.
+ */
+int ladder_index_num_words(const LadderIndex* index) {
+    return index->header->numWords;
+}
+
+/* compare_slots()
+ * ---------------
+ * qsort() comparator for ids.
+ */
+static int compare_slots(const void* first, const void* second) {
+    uint32_t a = *(const uint32_t*)first;
+    uint32_t b = *(const uint32_t*)second;
+    return (a > b) - (a < b);
+}
+
+/* check_table()
+ * -------------
+ * Checks that the hash table holds exactly the indexed words.
+ *
+ * Returns: the number of problems found.
+ */
+static int check_table(const LadderIndex* index, FILE* report) {
+    int problems = 0;
+    uint32_t numEntries = 0;
+    uint32_t numLive = 0;
+    for (uint32_t i = 0; i < index->header->tableSize; i++) {
+	uint32_t entry = index->table[i];
+	if (entry != TABLE_EMPTY && (entry - 1 >= index->header->numSlots ||
+		slot_word(index, entry - 1)[0] == '\0')) {
+	    problems++;
+	} else if (entry != TABLE_EMPTY) {
+	    numEntries++;
+	}
+    }
+    for (uint32_t slot = 0; slot < index->header->numSlots; slot++) {
+	const char* word = slot_word(index, slot);
+	if (word[0] == '\0') {
+	    continue;
+	}
+	numLive++;
+	if (find_slot(index, word) != slot) {
+	    if (problems++ < MAX_REPORTED_PROBLEMS) {
+		fprintf(report, "uqwordladder: %s cannot be looked up\n",
+			word);
+	    }
+	}
+    }
+    if (numEntries != numLive || numLive != index->header->numWords) {
+	problems++;
+	fprintf(report, "uqwordladder: index holds %u words but counts %u\n",
+		numLive, index->header->numWords);
+    }
+    return problems;
+}
+
+/* ladder_index_check()
+ * --------------------
+ * Compares an index against a full rebuild: the hash table must hold
+ * 	exactly the indexed words and every word's stored neighbours must be
+ * 	the neighbours found by building the one-letter graph from scratch.
+ *
+ * index: the index to check.
+ * report: the stream to describe problems on.
+ *
+ * Returns: the number of problems found (0 if the index is consistent).
+ */
+int ladder_index_check(const LadderIndex* index, FILE* report) {
+    int problems = check_table(index, report);
+    WordGraph* stored;
+    Dictionary* dict = ladder_index_dictionary(index, &stored);
+    if (dict == NULL) {
+	fprintf(report, "uqwordladder: index has dangling neighbours or "
+		"repeated words\n");
+	return problems + 1;
+    }
+    WordGraph* rebuilt = word_graph_build(dict);
+    for (int id = 0; id < dict->numWords; id++) {
+	int degree = word_graph_degree(stored, id);
+	uint32_t* storedRun = stored->neighbours + stored->offsets[id];
+	qsort(storedRun, degree, sizeof(uint32_t), compare_slots);
+	if (degree != word_graph_degree(rebuilt, id) || memcmp(storedRun,
+		rebuilt->neighbours + rebuilt->offsets[id],
+		sizeof(uint32_t) * degree) != 0) {
+	    if (problems++ < MAX_REPORTED_PROBLEMS) {
+		fprintf(report, "uqwordladder: %s has different neighbours "
+			"in the index (%d) and a rebuild (%d)\n",
+			dictionary_word(dict, id), degree,
+			word_graph_degree(rebuilt, id));
+	    }
+	}
+    }
+    word_graph_free(rebuilt);
+    word_graph_free(stored);
+    dictionary_free(dict);
+    return problems;
+}
+
+/* ladder_index_close()
+ * --------------------
+ * Unmaps and closes an index, which releases its lock.
+ *
+ * index: the index to close.
+ */
+void ladder_index_close(LadderIndex* index) {
+    munmap(index->map, index->mapSize);
+    close(index->fd);
+    free(index->path);
+    free(index);
+}
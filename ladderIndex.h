@@ -0,0 +1,62 @@
+/*
+ * CSSE2310 A1
+ * UQWordLadder
+ * Persistent, editable index of the words of one length and their
+ * one-letter adjacency.
+ */
+
+#ifndef LADDER_INDEX_H
+#define LADDER_INDEX_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "dictionary.h"
+#include "wordGraph.h"
+
+typedef enum {
+    INDEX_OK,
+    INDEX_MISSING,
+    INDEX_UNAVAILABLE,
+    INDEX_INVALID,
+    INDEX_DIRTY
+} IndexStatus;
+
+typedef struct IndexHeader IndexHeader;
+typedef struct AdjacencyHead AdjacencyHead;
+
+/* LadderIndex
+ * -----------
+ * An index file mapped into memory. Words live in slots; removing a word
+ * leaves an empty slot behind until the file is next compacted. Each slot
+ * owns a run of the edge area holding the slots of its neighbours.
+ */
+typedef struct {
+    char* path;
+    int fd;
+    bool writable;
+    size_t mapSize;
+    char* map;
+    IndexHeader* header;
+    char* words;
+    AdjacencyHead* heads;
+    uint32_t* table;
+    uint32_t* edges;
+} LadderIndex;
+
+bool ladder_index_create(const char* path, char** words, int numWords,
+	int length);
+LadderIndex* ladder_index_open(const char* path, int length, bool writable,
+	IndexStatus* status);
+bool ladder_index_add(LadderIndex* index, const char* word, bool* added);
+bool ladder_index_remove(LadderIndex* index, const char* word,
+	bool* removed);
+bool ladder_index_begin_edits(LadderIndex* index);
+void ladder_index_end_edits(LadderIndex* index);
+int ladder_index_num_words(const LadderIndex* index);
+Dictionary* ladder_index_dictionary(const LadderIndex* index,
+	WordGraph** graph);
+int ladder_index_check(const LadderIndex* index, FILE* report);
+void ladder_index_close(LadderIndex* index);
+
+#endif
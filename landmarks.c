@@ -0,0 +1,340 @@
+/*
+ * CSSE2310 A1
+ * UQWordLadder
+ * Landmark (ALT) distance oracle for exact ladder lengths.
+ *
+ * All-pairs tables of 7 to 9 letter dictionaries are far too big, so only
+ * the distances from a handful of landmarks are kept (one byte per word per
+ * landmark). Those give lower bounds which steer an A* search straight
+ * towards the target instead of flooding the graph like breadth-first
+ * search does.
+ */
+
+#include <stdlib.h>
+#include "landmarks.h"
+
+#define HEAP_ID_BITS 32
+#define HEAP_ID_MASK 0xFFFFFFFFu
+
+/* next_stamp()
+ * ------------
+ * Starts a new search, so that words reached or settled by earlier searches
+ * 	count as untouched without clearing the scratch arrays.
+ *
+ * Returns: the stamp of the new search.
+ */
+static uint32_t next_stamp(LandmarkOracle* oracle) {
+    if (++oracle->stamp == 0) {
+	// The stamp wrapped around: old stamps could look current.
+	for (int id = 0; id < oracle->numWords; id++) {
+	    oracle->reached[id] = 0;
+	    oracle->settled[id] = 0;
+	}
+	oracle->stamp = 1;
+    }
+    return oracle->stamp;
+}
+
+/* landmark_distances()
+ * --------------------
+ * Fills in one landmark's row of distances with a breadth-first search.
+ *
+ * oracle: the oracle.
+ * graph: the one-letter graph.
+ * landmark: the index of the landmark to fill in.
+ */
+static void landmark_distances(LandmarkOracle* oracle,
+	const WordGraph* graph, int landmark) {
+    uint8_t* row = oracle->distances + (size_t)landmark * oracle->numWords;
+    uint32_t* queue = oracle->steps;
+    for (int id = 0; id < oracle->numWords; id++) {
+	row[id] = LANDMARK_UNREACHABLE;
+    }
+    int head = 0;
+    int tail = 0;
+    uint32_t source = oracle->landmarks[landmark];
+    row[source] = 0;
+    queue[tail++] = source;
+    while (head < tail) {
+	uint32_t id = queue[head++];
+	int distance = row[id] < LANDMARK_MAX_DISTANCE ? row[id] + 1 :
+		LANDMARK_MAX_DISTANCE;
+	const uint32_t* neighbours = graph->neighbours + graph->offsets[id];
+	for (int j = 0; j < word_graph_degree(graph, id); j++) {
+	    if (row[neighbours[j]] == LANDMARK_UNREACHABLE) {
+		row[neighbours[j]] = distance;
+		queue[tail++] = neighbours[j];
+	    }
+	}
+    }
+}
+
+/* landmark_oracle_build()
+ * -----------------------
+ * Picks landmarks by farthest-point selection and records their distances.
+ * 	The first landmark is the word farthest from the best connected word.
+ * 	Each later one is the word farthest from all landmarks so far, among
+ * 	the words they reach, which spreads the landmarks around the edge of
+ * 	the largest connected group of words where bounds help most.
+ *
+ * graph: the one-letter graph of the words.
+ * numLandmarks: the number of landmarks wanted (at most MAX_LANDMARKS).
+ *
+ * Returns: a pointer to the new oracle, which may have fewer landmarks than
+ * 	asked for if there are fewer suitable words.
+ */
+LandmarkOracle* landmark_oracle_build(const WordGraph* graph,
+	int numLandmarks) {
+    int numWords = graph->numWords;
+    LandmarkOracle* oracle = malloc(sizeof(LandmarkOracle));
+    oracle->numLandmarks = 0;
+    oracle->numWords = numWords;
+    oracle->landmarks = malloc(sizeof(uint32_t) * MAX_LANDMARKS);
+    oracle->distances = malloc((size_t)numLandmarks * numWords + 1);
+    oracle->stamp = 0;
+    oracle->reached = calloc(numWords + 1, sizeof(uint32_t));
+    oracle->settled = calloc(numWords + 1, sizeof(uint32_t));
+    oracle->steps = malloc(sizeof(uint32_t) * (numWords + 1));
+    // Room for a queue of every word, or a heap entry for every edge.
+    oracle->heap = malloc(sizeof(uint64_t) *
+	    (graph->offsets[numWords] + numWords + 1));
+    if (numWords == 0) {
+	return oracle;
+    }
+
+    int hub = 0;
+    for (int id = 1; id < numWords; id++) {
+	if (word_graph_degree(graph, id) > word_graph_degree(graph, hub)) {
+	    hub = id;
+	}
+    }
+    // Start from the hub; its row is replaced by the real first landmark.
+    oracle->landmarks[0] = hub;
+    landmark_distances(oracle, graph, 0);
+    uint8_t* nearest = malloc(numWords + 1);
+    for (int id = 0; id < numWords; id++) {
+	nearest[id] = oracle->distances[id];
+    }
+    while (oracle->numLandmarks < numLandmarks) {
+	int farthest = -1;
+	for (int id = 0; id < numWords; id++) {
+	    if (nearest[id] != LANDMARK_UNREACHABLE && (farthest == -1 ||
+		    nearest[id] > nearest[farthest])) {
+		farthest = id;
+	    }
+	}
+	if (farthest == -1 || (oracle->numLandmarks > 0 &&
+		nearest[farthest] == 0)) {
+	    break;
+	}
+	int landmark = oracle->numLandmarks++;
+	oracle->landmarks[landmark] = farthest;
+	landmark_distances(oracle, graph, landmark);
+	const uint8_t* row = oracle->distances + (size_t)landmark * numWords;
+	for (int id = 0; id < numWords; id++) {
+	    if (landmark == 0 || row[id] < nearest[id]) {
+		nearest[id] = row[id];
+	    }
+	}
+    }
+    free(nearest);
+    return oracle;
+}
+
+/* landmark_lower_bound()
+ * ----------------------
+ * Works out the best landmark lower bound on the steps between two words.
+ *
+ * oracle: the oracle.
+ * source: the id of the first word.
+ * target: the id of the second word.
+ *
+ * Returns: a lower bound on the number of steps, or LANDMARK_UNREACHABLE
+ * 	if a landmark reaches one word but not the other (so there is no
+ * 	ladder between them).
+ */
+int landmark_lower_bound(const LandmarkOracle* oracle, int source,
+	int target) {
+    int best = 0;
+    const uint8_t* row = oracle->distances;
+    for (int l = 0; l < oracle->numLandmarks; l++) {
+	int fromSource = row[source];
+	int fromTarget = row[target];
+	if ((fromSource == LANDMARK_UNREACHABLE) !=
+		(fromTarget == LANDMARK_UNREACHABLE)) {
+	    return LANDMARK_UNREACHABLE;
+	}
+	int bound = fromSource > fromTarget ? fromSource - fromTarget :
+		fromTarget - fromSource;
+	if (fromSource != LANDMARK_UNREACHABLE && bound > best) {
+	    best = bound;
+	}
+	row += oracle->numWords;
+    }
+    return best;
+}
+
+/* heap_push()
+ * -----------
+ * Adds a word to the search's binary min-heap, keyed by its estimate.
+ */
+static void heap_push(uint64_t* heap, int* size, uint32_t estimate,
+	uint32_t id) {
+    uint64_t key = ((uint64_t)estimate << HEAP_ID_BITS) | id;
+    int i = (*size)++;
+    while (i > 0 && heap[(i - 1) / 2] > key) {
+	heap[i] = heap[(i - 1) / 2];
+	i = (i - 1) / 2;
+    }
+    heap[i] = key;
+}
+
+/* heap_pop()
+ * ----------
+ * Returns: the id of the word with the smallest estimate, which is removed
+ * 	from the heap.
+ */
+static uint32_t heap_pop(uint64_t* heap, int* size) {
+    uint64_t top = heap[0];
+    uint64_t last = heap[--(*size)];
+    int i = 0;
+    while (2 * i + 1 < *size) {
+	int child = 2 * i + 1;
+	if (child + 1 < *size && heap[child + 1] < heap[child]) {
+	    child++;
+	}
+	if (heap[child] >= last) {
+	    break;
+	}
+	heap[i] = heap[child];
+	i = child;
+    }
+    heap[i] = last;
+    return top & HEAP_ID_MASK;
+}
+
+/* landmark_search()
+ * -----------------
+ * Finds the exact number of steps between two words with A* search. The
+ * 	estimate of the steps left from a word is the larger of the landmark
+ * 	bound and the given word bound. Both are consistent, so each word is
+ * 	settled at most once.
+ *
+ * oracle: the oracle.
+ * dict: the dictionary the graph was built from.
+ * graph: the one-letter graph.
+ * bound: an extra lower bound on the steps between two words, or NULL.
+ * source: the id of the first word.
+ * target: the id of the last word.
+ * searched: a pointer to store the number of words settled in.
+ *
+ * Returns: the number of steps, or NO_LADDER if there is no ladder.
+ */
+int landmark_search(LandmarkOracle* oracle, const Dictionary* dict,
+	const WordGraph* graph, WordBound bound, int source, int target,
+	int* searched) {
+    *searched = 0;
+    if (landmark_lower_bound(oracle, source, target) ==
+	    LANDMARK_UNREACHABLE) {
+	return NO_LADDER;
+    }
+    uint32_t stamp = next_stamp(oracle);
+    const char* targetWord = dictionary_word(dict, target);
+    int heapSize = 0;
+    oracle->reached[source] = stamp;
+    oracle->steps[source] = 0;
+    heap_push(oracle->heap, &heapSize, 0, source);
+    while (heapSize > 0) {
+	uint32_t id = heap_pop(oracle->heap, &heapSize);
+	if (oracle->settled[id] == stamp) {
+	    // A stale entry from before the word's steps improved.
+	    continue;
+	}
+	oracle->settled[id] = stamp;
+	(*searched)++;
+	if ((int)id == target) {
+	    return oracle->steps[id];
+	}
+	uint32_t nextSteps = oracle->steps[id] + 1;
+	const uint32_t* neighbours = graph->neighbours + graph->offsets[id];
+	for (int j = 0; j < word_graph_degree(graph, id); j++) {
+	    uint32_t next = neighbours[j];
+	    if (oracle->settled[next] == stamp ||
+		    (oracle->reached[next] == stamp &&
+		    oracle->steps[next] <= nextSteps)) {
+		continue;
+	    }
+	    int estimate = landmark_lower_bound(oracle, next, target);
+	    if (estimate == LANDMARK_UNREACHABLE) {
+		continue;
+	    }
+	    if (bound != NULL) {
+		int wordEstimate = bound(dictionary_word(dict, next),
+			targetWord);
+		estimate = wordEstimate > estimate ? wordEstimate : estimate;
+	    }
+	    oracle->reached[next] = stamp;
+	    oracle->steps[next] = nextSteps;
+	    heap_push(oracle->heap, &heapSize, nextSteps + estimate, next);
+	}
+    }
+    return NO_LADDER;
+}
+
+/* landmark_bfs()
+ * --------------
+ * Finds the exact number of steps between two words with plain
+ * 	breadth-first search, for comparison with landmark_search().
+ *
+ * oracle: the oracle, whose scratch space is used.
+ * graph: the one-letter graph.
+ * source: the id of the first word.
+ * target: the id of the last word.
+ * searched: a pointer to store the number of words dequeued in.
+ *
+ * Returns: the number of steps, or NO_LADDER if there is no ladder.
+ */
+int landmark_bfs(LandmarkOracle* oracle, const WordGraph* graph,
+	int source, int target, int* searched) {
+    uint32_t stamp = next_stamp(oracle);
+    // The heap doubles as the queue.
+    uint64_t* queue = oracle->heap;
+    int head = 0;
+    int tail = 0;
+    oracle->reached[source] = stamp;
+    oracle->steps[source] = 0;
+    queue[tail++] = source;
+    while (head < tail) {
+	uint32_t id = queue[head++];
+	if ((int)id == target) {
+	    *searched = head;
+	    return oracle->steps[id];
+	}
+	const uint32_t* neighbours = graph->neighbours + graph->offsets[id];
+	for (int j = 0; j < word_graph_degree(graph, id); j++) {
+	    if (oracle->reached[neighbours[j]] != stamp) {
+		oracle->reached[neighbours[j]] = stamp;
+		oracle->steps[neighbours[j]] = oracle->steps[id] + 1;
+		queue[tail++] = neighbours[j];
+	    }
+	}
+    }
+    *searched = head;
+    return NO_LADDER;
+}
+
+/* landmark_oracle_free()
+ * ----------------------
+ * Frees an oracle.
+ *
+ * oracle: the oracle to free.
+ */
+void landmark_oracle_free(LandmarkOracle* oracle) {
+    free(oracle->landmarks);
+    free(oracle->distances);
+    free(oracle->reached);
+    free(oracle->settled);
+    free(oracle->steps);
+    free(oracle->heap);
+    free(oracle);
+}
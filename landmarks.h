@@ -0,0 +1,56 @@
+/*
+ * CSSE2310 A1
+ * UQWordLadder
+ * Landmark (ALT) distance oracle for exact ladder lengths.
+ */
+
+#ifndef LANDMARKS_H
+#define LANDMARKS_H
+
+#include <stdint.h>
+#include "dictionary.h"
+#include "wordGraph.h"
+
+#define MAX_LANDMARKS 16
+// Distances are stored in a byte. Longer ones are clamped, which keeps the
+// lower bounds valid (just less tight).
+#define LANDMARK_MAX_DISTANCE 254
+#define LANDMARK_UNREACHABLE 255
+#define NO_LADDER (-1)
+
+/* A lower bound on the steps between two words, used alongside the
+ * landmark bounds (e.g. the number of differing letters). */
+typedef int (*WordBound)(const char* firstWord, const char* secondWord);
+
+/* LandmarkOracle
+ * --------------
+ * Breadth-first distances from a few landmark words to every word of one
+ * length: distances[l * numWords + id] is the number of steps between
+ * landmark l and word id, or LANDMARK_UNREACHABLE. By the triangle
+ * inequality, |d(l, a) - d(l, b)| never overestimates the steps from a to
+ * b. The remaining fields are scratch space reused by every search.
+ */
+typedef struct {
+    int numLandmarks;
+    int numWords;
+    uint32_t* landmarks;
+    uint8_t* distances;
+    uint32_t stamp;
+    uint32_t* reached;
+    uint32_t* settled;
+    uint32_t* steps;
+    uint64_t* heap;
+} LandmarkOracle;
+
+LandmarkOracle* landmark_oracle_build(const WordGraph* graph,
+	int numLandmarks);
+int landmark_lower_bound(const LandmarkOracle* oracle, int source,
+	int target);
+int landmark_search(LandmarkOracle* oracle, const Dictionary* dict,
+	const WordGraph* graph, WordBound bound, int source, int target,
+	int* searched);
+int landmark_bfs(LandmarkOracle* oracle, const WordGraph* graph,
+	int source, int target, int* searched);
+void landmark_oracle_free(LandmarkOracle* oracle);
+
+#endif
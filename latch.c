@@ -0,0 +1,68 @@
+/*
+ * CSSE2310 A1
+ * UQWordLadder
+ * One-shot completion latch for handing work over between threads.
+ */
+
+#include "latch.h"
+#include "elapsed.h"
+
+/* latch_init()
+ * ------------
+ * Initialises a closed latch.
+ *
+ * latch: the latch to initialise.
+ */
+void latch_init(Latch* latch) {
+    pthread_mutex_init(&latch->mutex, NULL);
+    pthread_cond_init(&latch->released, NULL);
+    latch->isReleased = false;
+}
+
+/* latch_release()
+ * ---------------
+ * Releases a latch, waking every thread waiting on it.
+ *
+ * latch: the latch to release.
+ */
+void latch_release(Latch* latch) {
+    pthread_mutex_lock(&latch->mutex);
+    latch->isReleased = true;
+    pthread_cond_broadcast(&latch->released);
+    pthread_mutex_unlock(&latch->mutex);
+}
+
+/* latch_wait()
+ * ------------
+ * Waits until a latch has been released.
+ *
+ * latch: the latch to wait on.
+ *
+ * Returns: the number of milliseconds spent waiting (0 if the latch had
+ * 	already been released).
+ */
+double latch_wait(Latch* latch) {
+    struct timespec start;
+    double msec = 0;
+    pthread_mutex_lock(&latch->mutex);
+    if (!latch->isReleased) {
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	while (!latch->isReleased) {
+	    pthread_cond_wait(&latch->released, &latch->mutex);
+	}
+	msec = elapsed_msec(&start);
+    }
+    pthread_mutex_unlock(&latch->mutex);
+    return msec;
+}
+
+/* latch_destroy()
+ * ---------------
+ * Frees the resources of a latch which no thread is using any more.
+ *
+ * latch: the latch to destroy.
+ */
+void latch_destroy(Latch* latch) {
+    pthread_cond_destroy(&latch->released);
+    pthread_mutex_destroy(&latch->mutex);
+}
@@ -0,0 +1,30 @@
+/*
+ * CSSE2310 A1
+ * UQWordLadder
+ * One-shot completion latch for handing work over between threads.
+ */
+
+#ifndef LATCH_H
+#define LATCH_H
+
+#include <pthread.h>
+#include <stdbool.h>
+
+/* Latch
+ * -----
+ * Starts closed and is released exactly once. Everything the releasing
+ * thread wrote before latch_release() is visible to threads returning from
+ * latch_wait().
+ */
+typedef struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t released;
+    bool isReleased;
+} Latch;
+
+void latch_init(Latch* latch);
+void latch_release(Latch* latch);
+double latch_wait(Latch* latch);
+void latch_destroy(Latch* latch);
+
+#endif
@@ -0,0 +1,37 @@
+/*
+ * CSSE2310 A1
+ * UQWordLadder
+ * All of the word data a game needs, for every word length in play.
+ */
+
+#include <stdlib.h>
+#include "lexicon.h"
+
+/* lexicon_new()
+ * -------------
+ * Returns: a new lexicon with no word lengths in play.
+ */
+Lexicon* lexicon_new(void) {
+    return calloc(1, sizeof(Lexicon));
+}
+
+/* lexicon_free()
+ * --------------
+ * Frees a lexicon and everything in it.
+ *
+ * lexicon: the lexicon to free.
+ */
+void lexicon_free(Lexicon* lexicon) {
+    if (lexicon->deletions != NULL) {
+	deletion_index_free(lexicon->deletions);
+    }
+    for (int length = 0; length <= MAX_WORD_LENGTH; length++) {
+	if (lexicon->graphs[length] != NULL) {
+	    word_graph_free(lexicon->graphs[length]);
+	}
+	if (lexicon->dictionaries[length] != NULL) {
+	    dictionary_free(lexicon->dictionaries[length]);
+	}
+    }
+    free(lexicon);
+}
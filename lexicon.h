@@ -0,0 +1,33 @@
+/*
+ * CSSE2310 A1
+ * UQWordLadder
+ * All of the word data a game needs, for every word length in play.
+ */
+
+#ifndef LEXICON_H
+#define LEXICON_H
+
+#include "dictionary.h"
+#include "wordGraph.h"
+#include "deletionIndex.h"
+
+#define MAX_WORD_LENGTH 9
+// Room for any word in play and its terminating '\0'.
+#define WORD_BUFFER (MAX_WORD_LENGTH + 1)
+
+/* Lexicon
+ * -------
+ * Dictionaries (and their one-letter graphs, if built) indexed by word
+ * length. Lengths which are not in play are NULL. The deletion index is
+ * only built when letters may be added or removed.
+ */
+typedef struct {
+    Dictionary* dictionaries[MAX_WORD_LENGTH + 1];
+    WordGraph* graphs[MAX_WORD_LENGTH + 1];
+    DeletionIndex* deletions;
+} Lexicon;
+
+Lexicon* lexicon_new(void);
+void lexicon_free(Lexicon* lexicon);
+
+#endif
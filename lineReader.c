@@ -0,0 +1,146 @@
+/*
+ * CSSE2310 A1
+ * UQWordLadder
+ * Chunked line reader which hands out lines in place.
+ *
+ * Scripted players often send every move in one write. Reading a whole
+ * chunk at a time and splitting it in place means all of those moves are
+ * handled with one read() and no allocation per line.
+ */
+
+#include <ctype.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "lineReader.h"
+
+#define NUM_BYTES 256
+
+/* Upper-case version of every byte, filled in by line_reader_new(). */
+static unsigned char upperCase[NUM_BYTES];
+
+/* line_reader_new()
+ * -----------------
+ * Makes a line reader for a file descriptor.
+ *
+ * fd: the file descriptor to read from.
+ *
+ * Returns: a pointer to the new reader.
+ */
+LineReader* line_reader_new(int fd) {
+    for (int c = 0; c < NUM_BYTES; c++) {
+	upperCase[c] = toupper(c);
+    }
+    LineReader* reader = malloc(sizeof(LineReader));
+    reader->fd = fd;
+    reader->capacity = LINE_READER_CHUNK;
+    reader->buffer = malloc(reader->capacity + 1);
+    reader->start = 0;
+    reader->end = 0;
+    reader->isEof = false;
+    reader->isSkipping = false;
+    return reader;
+}
+
+/* fill_buffer()
+ * -------------
+ * Reads another chunk after the buffered bytes. The unread bytes are first
+ * 	moved to the front of the buffer. While skipping the rest of a long
+ * 	line, bytes before the next newline are dropped as they are read.
+ *
+ * reader: the reader to fill.
+ */
+static void fill_buffer(LineReader* reader) {
+    size_t unread = reader->end - reader->start;
+    if (reader->start > 0) {
+	memmove(reader->buffer, reader->buffer + reader->start, unread);
+	reader->start = 0;
+	reader->end = unread;
+    }
+    char* chunk = reader->buffer + reader->end;
+    ssize_t numRead;
+    do {
+	numRead = read(reader->fd, chunk, reader->capacity - reader->end);
+    } while (numRead < 0 && errno == EINTR);
+    if (numRead <= 0) {
+	reader->isEof = true;
+	return;
+    }
+    if (!reader->isSkipping) {
+	reader->end += numRead;
+	return;
+    }
+    char* newline = memchr(chunk, '\n', numRead);
+    if (newline != NULL) {
+	size_t kept = chunk + numRead - newline;
+	memmove(chunk, newline, kept);
+	reader->end += kept;
+	reader->isSkipping = false;
+    }
+}
+
+/* line_reader_next()
+ * ------------------
+ * Gets the next line, only reading more input once every buffered line has
+ * 	been handed out. A line which fills the whole buffer is cut to
+ * 	LINE_READER_MAX_LINE bytes and the rest of it is dropped, so it is
+ * 	still returned as one line.
+ *
+ * reader: the reader to get the line from.
+ * length: a pointer to store the length of the line in.
+ *
+ * Returns: a pointer to the line within the buffer, with its newline
+ * 	replaced by '\0', or NULL at the end of input. A last line with no
+ * 	newline is never returned (the input ended part way through it).
+ */
+char* line_reader_next(LineReader* reader, size_t* length) {
+    size_t searched = 0;
+    while (true) {
+	char* line = reader->buffer + reader->start;
+	char* newline = memchr(line + searched, '\n',
+		reader->end - reader->start - searched);
+	if (newline != NULL) {
+	    *newline = '\0';
+	    *length = newline - line;
+	    reader->start += *length + 1;
+	    return line;
+	}
+	if (reader->isEof) {
+	    return NULL;
+	}
+	// No need to search the same bytes again after more are read.
+	searched = reader->end - reader->start;
+	if (searched == reader->capacity) {
+	    // The line fills the buffer, so keep its start and drop the rest.
+	    searched = LINE_READER_MAX_LINE;
+	    reader->end = LINE_READER_MAX_LINE;
+	    reader->isSkipping = true;
+	}
+	fill_buffer(reader);
+    }
+}
+
+/* line_upper_case()
+ * -----------------
+ * Capitalises a line in place through a lookup table.
+ *
+ * line: the line to capitalise.
+ * length: the number of bytes in line.
+ */
+void line_upper_case(char* line, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+	line[i] = upperCase[(unsigned char)line[i]];
+    }
+}
+
+/* line_reader_free()
+ * ------------------
+ * Frees a line reader (but does not close its file descriptor).
+ *
+ * reader: the reader to free.
+ */
+void line_reader_free(LineReader* reader) {
+    free(reader->buffer);
+    free(reader);
+}
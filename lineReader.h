@@ -0,0 +1,40 @@
+/*
+ * CSSE2310 A1
+ * UQWordLadder
+ * Chunked line reader which hands out lines in place.
+ */
+
+#ifndef LINE_READER_H
+#define LINE_READER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#define LINE_READER_CHUNK 65536
+// Lines which fill the buffer are cut to this length, so it never grows.
+#define LINE_READER_MAX_LINE 1024
+
+/* LineReader
+ * ----------
+ * A reusable buffer of input read from a file descriptor in large chunks.
+ * Bytes from start to end have been read but not handed out yet. Lines are
+ * split in place, so a line stays valid until the next call to
+ * line_reader_next(). While isSkipping, the rest of a line which was too
+ * long is being dropped.
+ */
+typedef struct {
+    int fd;
+    char* buffer;
+    size_t capacity;
+    size_t start;
+    size_t end;
+    bool isEof;
+    bool isSkipping;
+} LineReader;
+
+LineReader* line_reader_new(int fd);
+char* line_reader_next(LineReader* reader, size_t* length);
+void line_upper_case(char* line, size_t length);
+void line_reader_free(LineReader* reader);
+
+#endif
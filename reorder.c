@@ -0,0 +1,277 @@
+/*
+ * CSSE2310 A1
+ * UQWordLadder
+ * Locality-aware reordering of word ids for cache-friendly graph walks.
+ *
+ * Dictionaries come out of the file in alphabetical order, so words one
+ * letter apart (e.g. HEAD and TEAD) usually end up far apart in memory.
+ * Numbering the words in breadth-first or reverse Cuthill-McKee order of
+ * the one-letter graph puts most neighbours close together instead.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "reorder.h"
+#include "cacheCounter.h"
+#include "elapsed.h"
+
+#define NUM_TRAVERSALS 16
+#define DEGREE_SHIFT 32
+
+/* reorder_parse()
+ * ---------------
+ * Parses the name of a reordering method.
+ *
+ * name: "bfs" or "rcm".
+ * method: a pointer to store the method in.
+ *
+ * Returns: true if name is a known method.
+ */
+bool reorder_parse(const char* name, ReorderMethod* method) {
+    if (strcmp(name, "bfs") == 0) {
+	*method = REORDER_BFS;
+	return true;
+    }
+    if (strcmp(name, "rcm") == 0) {
+	*method = REORDER_RCM;
+	return true;
+    }
+    return false;
+}
+
+/* compare_keys()
+ * --------------
+ * qsort() comparator for sort_by_degree() keys.
+ */
+static int compare_keys(const void* first, const void* second) {
+    uint64_t a = *(const uint64_t*)first;
+    uint64_t b = *(const uint64_t*)second;
+    return (a > b) - (a < b);
+}
+
+/* sort_by_degree()
+ * ----------------
+ * Sorts word ids by degree, then by id. Each id is packed into one key
+ * 	along with its degree, so the comparator needs no graph (and sorts on
+ * 	different threads cannot interfere).
+ *
+ * graph: the graph the words belong to.
+ * ids: the ids to sort.
+ * numIds: the number of ids.
+ * keys: scratch space for numIds keys.
+ */
+static void sort_by_degree(const WordGraph* graph, uint32_t* ids, int numIds,
+	uint64_t* keys) {
+    for (int i = 0; i < numIds; i++) {
+	keys[i] = (uint64_t)word_graph_degree(graph, ids[i]) << DEGREE_SHIFT |
+		ids[i];
+    }
+    qsort(keys, numIds, sizeof(uint64_t), compare_keys);
+    for (int i = 0; i < numIds; i++) {
+	ids[i] = (uint32_t)keys[i];
+    }
+}
+
+/* reorder_order()
+ * ---------------
+ * Works out a locality-friendly order of the words of a graph. Each
+ * 	connected component is numbered in breadth-first order. For
+ * 	REORDER_RCM, components start at a word of least degree, neighbours
+ * 	are visited in increasing degree order and the whole order is
+ * 	reversed (reverse Cuthill-McKee).
+ *
+ * graph: the graph to order.
+ * method: REORDER_BFS or REORDER_RCM.
+ *
+ * Returns: an array of numWords ids, where element i is the id of the word
+ * 	which should get id i.
+ */
+uint32_t* reorder_order(const WordGraph* graph, ReorderMethod method) {
+    int numWords = graph->numWords;
+    uint32_t* order = malloc(sizeof(uint32_t) * (numWords + 1));
+    uint32_t* starts = malloc(sizeof(uint32_t) * (numWords + 1));
+    uint64_t* keys = malloc(sizeof(uint64_t) * (numWords + 1));
+    char* visited = calloc(numWords + 1, sizeof(char));
+    for (int id = 0; id < numWords; id++) {
+	starts[id] = id;
+    }
+    if (method == REORDER_RCM) {
+	sort_by_degree(graph, starts, numWords, keys);
+    }
+
+    // order doubles as the breadth-first queue.
+    int tail = 0;
+    for (int s = 0; s < numWords; s++) {
+	if (visited[starts[s]]) {
+	    continue;
+	}
+	int head = tail;
+	visited[starts[s]] = 1;
+	order[tail++] = starts[s];
+	while (head < tail) {
+	    uint32_t id = order[head++];
+	    int firstNew = tail;
+	    const uint32_t* neighbours = graph->neighbours + graph->offsets[id];
+	    for (int j = 0; j < word_graph_degree(graph, id); j++) {
+		if (!visited[neighbours[j]]) {
+		    visited[neighbours[j]] = 1;
+		    order[tail++] = neighbours[j];
+		}
+	    }
+	    if (method == REORDER_RCM) {
+		sort_by_degree(graph, order + firstNew, tail - firstNew,
+			keys);
+	    }
+	}
+    }
+    if (method == REORDER_RCM) {
+	for (int i = 0; i < numWords / 2; i++) {
+	    uint32_t temp = order[i];
+	    order[i] = order[numWords - 1 - i];
+	    order[numWords - 1 - i] = temp;
+	}
+    }
+    free(visited);
+    free(keys);
+    free(starts);
+    return order;
+}
+
+/* traverse()
+ * ----------
+ * Walks the graph breadth-first from a word, reading every word reached
+ * 	the way a ladder search does.
+ *
+ * dict: the dictionary the graph was built from.
+ * graph: the graph to walk.
+ * source: the id of the word to start from.
+ * queue: scratch space for numWords ids.
+ * visited: scratch space for numWords flags, which must be all zero.
+ *
+ * Returns: a checksum of the letters read, so the reads are not optimised
+ * 	away.
+ */
+static unsigned traverse(const Dictionary* dict, const WordGraph* graph,
+	int source, uint32_t* queue, char* visited) {
+    unsigned checksum = 0;
+    int head = 0;
+    int tail = 0;
+    visited[source] = 1;
+    queue[tail++] = source;
+    while (head < tail) {
+	uint32_t id = queue[head++];
+	const char* word = dictionary_word(dict, id);
+	for (int i = 0; i < dict->length; i++) {
+	    checksum = checksum * 31 + word[i];
+	}
+	const uint32_t* neighbours = graph->neighbours + graph->offsets[id];
+	for (int j = 0; j < word_graph_degree(graph, id); j++) {
+	    if (!visited[neighbours[j]]) {
+		visited[neighbours[j]] = 1;
+		queue[tail++] = neighbours[j];
+	    }
+	}
+    }
+    // Clear only the flags that were set.
+    for (int i = 0; i < tail; i++) {
+	visited[queue[i]] = 0;
+    }
+    return checksum;
+}
+
+/* measure_traversals()
+ * --------------------
+ * Measures NUM_TRAVERSALS traversals which start from words spread evenly
+ * 	through the dictionary file, after one warm-up round.
+ *
+ * dict: the dictionary the graph was built from.
+ * graph: the graph to walk.
+ * counter: a counter from cache_counter_open().
+ * misses: a pointer to store the cache misses per traversal in, or
+ * 	CACHE_COUNTER_UNAVAILABLE.
+ * msec: a pointer to store the milliseconds per traversal in.
+ */
+static void measure_traversals(const Dictionary* dict,
+	const WordGraph* graph, int counter, double* misses, double* msec) {
+    uint32_t* queue = malloc(sizeof(uint32_t) * (dict->numWords + 1));
+    char* visited = calloc(dict->numWords + 1, sizeof(char));
+    volatile unsigned checksum = 0;
+    long long totalMisses = 0;
+    struct timespec start;
+    double roundMsec = 0;
+
+    for (int round = 0; round < 2; round++) {
+	// Round 0 warms the caches up, round 1 is measured.
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	cache_counter_start(counter);
+	for (int t = 0; t < NUM_TRAVERSALS; t++) {
+	    int position = (int)((long long)dict->numWords * t /
+		    NUM_TRAVERSALS);
+	    checksum += traverse(dict, graph,
+		    dictionary_file_id(dict, position), queue, visited);
+	}
+	totalMisses = cache_counter_stop(counter);
+	roundMsec = elapsed_msec(&start);
+    }
+    *misses = totalMisses == CACHE_COUNTER_UNAVAILABLE ?
+	    CACHE_COUNTER_UNAVAILABLE : (double)totalMisses / NUM_TRAVERSALS;
+    *msec = roundMsec / NUM_TRAVERSALS;
+    free(visited);
+    free(queue);
+}
+
+/* report_traversals()
+ * -------------------
+ * Prints one line of traversal measurements.
+ */
+static void report_traversals(FILE* report, const char* label,
+	double misses, double msec) {
+    if (misses == CACHE_COUNTER_UNAVAILABLE) {
+	fprintf(report, "uqwordladder: %s: cache misses unavailable, "
+		"%.3f ms per traversal\n", label, msec);
+    } else {
+	fprintf(report, "uqwordladder: %s: %.1f cache misses, %.3f ms per "
+		"traversal\n", label, misses, msec);
+    }
+}
+
+/* reorder_words()
+ * ---------------
+ * Renumbers the words of a dictionary and its graph for locality, and
+ * 	reports cache misses per traversal before and after. The file order
+ * 	is kept in the new dictionary for printing words in.
+ *
+ * dict: a pointer to the dictionary, which is replaced by the reordered
+ * 	one (the old one is freed).
+ * graph: a pointer to the graph of the dictionary, which is replaced in
+ * 	the same way.
+ * method: REORDER_BFS or REORDER_RCM.
+ * report: the stream to print measurements to.
+ */
+void reorder_words(Dictionary** dict, WordGraph** graph,
+	ReorderMethod method, FILE* report) {
+    if ((*dict)->numWords == 0) {
+	return;
+    }
+    int counter = cache_counter_open();
+    double missesBefore, msecBefore, missesAfter, msecAfter;
+    measure_traversals(*dict, *graph, counter, &missesBefore, &msecBefore);
+
+    uint32_t* order = reorder_order(*graph, method);
+    Dictionary* reordered = dictionary_reorder(*dict, order);
+    WordGraph* permuted = word_graph_permute(*graph, order);
+    free(order);
+    dictionary_free(*dict);
+    word_graph_free(*graph);
+    *dict = reordered;
+    *graph = permuted;
+
+    measure_traversals(*dict, *graph, counter, &missesAfter, &msecAfter);
+    cache_counter_close(counter);
+
+    fprintf(report, "uqwordladder: reordered %d words of length %d (%s)\n",
+	    (*dict)->numWords, (*dict)->length,
+	    method == REORDER_RCM ? "rcm" : "bfs");
+    report_traversals(report, "before", missesBefore, msecBefore);
+    report_traversals(report, "after", missesAfter, msecAfter);
+}
@@ -0,0 +1,27 @@
+/*
+ * CSSE2310 A1
+ * UQWordLadder
+ * Locality-aware reordering of word ids for cache-friendly graph walks.
+ */
+
+#ifndef REORDER_H
+#define REORDER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "dictionary.h"
+#include "wordGraph.h"
+
+typedef enum {
+    REORDER_NONE,
+    REORDER_BFS,
+    REORDER_RCM
+} ReorderMethod;
+
+bool reorder_parse(const char* name, ReorderMethod* method);
+uint32_t* reorder_order(const WordGraph* graph, ReorderMethod method);
+void reorder_words(Dictionary** dict, WordGraph** graph,
+	ReorderMethod method, FILE* report);
+
+#endif
@@ -0,0 +1,315 @@
+/*
+ * CSSE2310 A1
+ * UQWordLadder
+ * Dictionaries shared between game processes through POSIX shared memory.
+ *
+ * The first process to load a (dictionary file, word length) pair publishes
+ * the packed dictionary in a segment named after the user, the file and the
+ * length. The first page of the segment holds a SegmentHeader and the packed
+ * block starts on the second page, so it can be mapped on its own.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "sharedDict.h"
+
+#define SEGMENT_MAGIC "UQWLDICT"
+#define SEGMENT_MAGIC_SIZE 8
+// Bump whenever the header or the packed block layout changes.
+#define SEGMENT_VERSION 2
+#define SEGMENT_BUILDING 1
+#define SEGMENT_READY 2
+#define SEGMENT_NAME_BUFFER 64
+#define ATTACH_ATTEMPTS 50
+#define ATTACH_RETRY_NSEC 20000000
+
+/* Result of checking a segment header against the expected dictionary. */
+typedef enum {
+    HEADER_VALID,
+    HEADER_INCOMPLETE,
+    HEADER_STALE
+} HeaderStatus;
+
+typedef struct {
+    char magic[SEGMENT_MAGIC_SIZE];
+    uint32_t version;
+    uint32_t state;
+    int32_t creatorPid;
+    int32_t length;
+    int32_t numWords;
+    int32_t sections;
+    uint64_t blockSize;
+    // Identity of the dictionary file the segment was built from.
+    uint64_t sourceDev;
+    uint64_t sourceIno;
+    int64_t sourceSize;
+    int64_t sourceMtimeSec;
+    int64_t sourceMtimeNsec;
+} SegmentHeader;
+
+/* segment_name()
+ * --------------
+ * Makes the shared-memory name for a dictionary file and word length.
+ *
+ * filePath: the path of the dictionary file.
+ * length: the length of words in the dictionary.
+ * name: a buffer of SEGMENT_NAME_BUFFER characters to store the name in.
+ */
+static void segment_name(const char* filePath, int length, char* name) {
+    char resolved[PATH_MAX];
+    const char* path = realpath(filePath, resolved) ? resolved : filePath;
+    // 64-bit FNV-1a of the resolved path.
+    uint64_t hash = 14695981039346656037ull;
+    for (const char* c = path; *c != '\0'; c++) {
+	hash ^= (unsigned char)*c;
+	hash *= 1099511628211ull;
+    }
+    snprintf(name, SEGMENT_NAME_BUFFER, "/uqwordladder-%u-%016llx-%d",
+	    (unsigned)geteuid(), (unsigned long long)hash, length);
+}
+
+/* header_page_size()
+ * ------------------
+ * Returns: the number of bytes reserved for the header, which is one page
+ * 	so the packed block can be mapped at a page-aligned offset.
+ */
+static size_t header_page_size(void) {
+    return (size_t)sysconf(_SC_PAGESIZE);
+}
+
+/* process_alive()
+ * ---------------
+ * Returns: true if a process with the given pid exists.
+ */
+static bool process_alive(pid_t pid) {
+    return pid > 0 && (kill(pid, 0) == 0 || errno == EPERM);
+}
+
+/* check_header()
+ * --------------
+ * Checks whether a segment header describes a usable dictionary.
+ *
+ * header: the mapped header of the segment.
+ * source: the stat of the dictionary file the caller wants.
+ * length: the length of words the caller wants.
+ * segmentSize: the size of the segment in bytes.
+ *
+ * Returns: HEADER_VALID if the segment is ready and was built from the same
+ * 	file and length, HEADER_INCOMPLETE if a live process is still
+ * 	building it, or HEADER_STALE if it can never become usable.
+ */
+static HeaderStatus check_header(const SegmentHeader* header,
+	const struct stat* source, int length, off_t segmentSize) {
+    static const char zeroMagic[SEGMENT_MAGIC_SIZE];
+    // A zero magic means the creator has not filled the header in yet,
+    // unless it died part way through (its pid is written first).
+    if (memcmp(header->magic, zeroMagic, SEGMENT_MAGIC_SIZE) == 0) {
+	pid_t creatorPid = __atomic_load_n(&header->creatorPid,
+		__ATOMIC_RELAXED);
+	return creatorPid == 0 || process_alive(creatorPid) ?
+		HEADER_INCOMPLETE : HEADER_STALE;
+    }
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    if (memcmp(header->magic, SEGMENT_MAGIC, SEGMENT_MAGIC_SIZE) != 0 ||
+	    header->version != SEGMENT_VERSION || header->length != length ||
+	    header->sourceDev != (uint64_t)source->st_dev ||
+	    header->sourceIno != (uint64_t)source->st_ino ||
+	    header->sourceSize != (int64_t)source->st_size ||
+	    header->sourceMtimeSec != (int64_t)source->st_mtim.tv_sec ||
+	    header->sourceMtimeNsec != (int64_t)source->st_mtim.tv_nsec ||
+	    header->blockSize != dictionary_block_size(length,
+	    header->numWords, header->sections) ||
+	    header->blockSize + header_page_size() > (uint64_t)segmentSize) {
+	return HEADER_STALE;
+    }
+    if (__atomic_load_n(&header->state, __ATOMIC_ACQUIRE) == SEGMENT_READY) {
+	return HEADER_VALID;
+    }
+    if (process_alive(header->creatorPid)) {
+	return HEADER_INCOMPLETE;
+    }
+    // The creator died before finishing the segment.
+    return HEADER_STALE;
+}
+
+/* remove_stale_segment()
+ * ----------------------
+ * Unlinks a stale segment, but only if the name still refers to the segment
+ * 	that was checked (another process may already have replaced it).
+ * 	Processes which still have the old segment mapped are unaffected.
+ *
+ * name: the shared-memory name of the segment.
+ * staleIno: the inode of the segment which was found to be stale.
+ */
+static void remove_stale_segment(const char* name, ino_t staleIno) {
+    int fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0) {
+	return;
+    }
+    struct stat current;
+    if (fstat(fd, &current) == 0 && current.st_ino == staleIno) {
+	shm_unlink(name);
+    }
+    close(fd);
+}
+
+/* map_dictionary()
+ * ----------------
+ * Maps the packed block of a valid segment read-only.
+ *
+ * fd: the open segment.
+ * header: the mapped header of the segment.
+ *
+ * Returns: a dictionary backed by the segment, or NULL if it cannot be
+ * 	mapped.
+ */
+static Dictionary* map_dictionary(int fd, const SegmentHeader* header) {
+    void* block = mmap(NULL, header->blockSize, PROT_READ, MAP_SHARED, fd,
+	    header_page_size());
+    if (block == MAP_FAILED) {
+	return NULL;
+    }
+    return dictionary_from_block(block, header->blockSize, header->length,
+	    header->numWords, header->sections, true);
+}
+
+/* shared_dictionary_attach()
+ * --------------------------
+ * Attaches read-only to the shared dictionary for a file and word length,
+ * 	waiting briefly if another process is still publishing it. Stale
+ * 	segments (built from an older version of the file, by an older
+ * 	program, or abandoned half-built) are unlinked.
+ *
+ * filePath: the path of the dictionary file.
+ * length: the length of words in the dictionary.
+ *
+ * Returns: the shared dictionary, or NULL if there is no usable segment and
+ * 	the caller should load the dictionary itself.
+ */
+Dictionary* shared_dictionary_attach(const char* filePath, int length) {
+    struct stat source;
+    if (stat(filePath, &source) != 0) {
+	return NULL;
+    }
+    char name[SEGMENT_NAME_BUFFER];
+    segment_name(filePath, length, name);
+    size_t headerSize = header_page_size();
+    struct timespec retryDelay = {0, ATTACH_RETRY_NSEC};
+    ino_t waitedIno = 0;
+    bool creatorKnown = false;
+
+    for (int attempt = 0; attempt < ATTACH_ATTEMPTS; attempt++) {
+	int fd = shm_open(name, O_RDONLY, 0);
+	if (fd < 0) {
+	    return NULL;
+	}
+	struct stat segment;
+	// Never trust a segment created by someone else.
+	if (fstat(fd, &segment) != 0 || segment.st_uid != geteuid()) {
+	    close(fd);
+	    return NULL;
+	}
+	HeaderStatus status = HEADER_INCOMPLETE;
+	Dictionary* dict = NULL;
+	creatorKnown = false;
+	if (segment.st_size >= (off_t)headerSize) {
+	    SegmentHeader* header = mmap(NULL, headerSize, PROT_READ,
+		    MAP_SHARED, fd, 0);
+	    if (header == MAP_FAILED) {
+		close(fd);
+		return NULL;
+	    }
+	    status = check_header(header, &source, length, segment.st_size);
+	    creatorKnown = header->creatorPid != 0;
+	    if (status == HEADER_VALID) {
+		dict = map_dictionary(fd, header);
+	    }
+	    munmap(header, headerSize);
+	}
+	if (status == HEADER_STALE) {
+	    remove_stale_segment(name, segment.st_ino);
+	}
+	close(fd);
+	if (status != HEADER_INCOMPLETE) {
+	    return dict;
+	}
+	waitedIno = segment.st_ino;
+	nanosleep(&retryDelay, NULL);
+    }
+    // A segment which never got a header was abandoned by its creator; one
+    // whose creator is still alive is just slow, so leave it be.
+    if (!creatorKnown) {
+	remove_stale_segment(name, waitedIno);
+    }
+    return NULL;
+}
+
+/* shared_dictionary_publish()
+ * ---------------------------
+ * Publishes a dictionary for other processes to attach to. Nothing happens
+ * 	if a segment already exists (another process got there first) or if
+ * 	shared memory is unavailable or full.
+ *
+ * filePath: the path of the dictionary file the dictionary was loaded from.
+ * length: the length of words in the dictionary.
+ * dict: the dictionary to publish.
+ */
+void shared_dictionary_publish(const char* filePath, int length,
+	const Dictionary* dict) {
+    struct stat source;
+    if (stat(filePath, &source) != 0) {
+	return;
+    }
+    char name[SEGMENT_NAME_BUFFER];
+    segment_name(filePath, length, name);
+    int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+	return;
+    }
+    size_t headerSize = header_page_size();
+    size_t segmentSize = headerSize + dict->blockSize;
+    char* segment = MAP_FAILED;
+    // Reserve the memory up front, as writing to a full tmpfs through a
+    // mapping raises SIGBUS rather than failing.
+    if (posix_fallocate(fd, 0, segmentSize) == 0) {
+	segment = mmap(NULL, segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED,
+		fd, 0);
+    }
+    if (segment == MAP_FAILED) {
+	shm_unlink(name);
+	close(fd);
+	return;
+    }
+
+    // Fill in the header first so that readers can tell the segment is
+    // being built, then copy the block and finally mark it as ready.
+    SegmentHeader* header = (SegmentHeader*)segment;
+    __atomic_store_n(&header->creatorPid, getpid(), __ATOMIC_RELAXED);
+    header->version = SEGMENT_VERSION;
+    header->state = SEGMENT_BUILDING;
+    header->length = length;
+    header->numWords = dict->numWords;
+    header->sections = dict->sections;
+    header->blockSize = dict->blockSize;
+    header->sourceDev = source.st_dev;
+    header->sourceIno = source.st_ino;
+    header->sourceSize = source.st_size;
+    header->sourceMtimeSec = source.st_mtim.tv_sec;
+    header->sourceMtimeNsec = source.st_mtim.tv_nsec;
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    memcpy(header->magic, SEGMENT_MAGIC, SEGMENT_MAGIC_SIZE);
+    memcpy(segment + headerSize, dict->block, dict->blockSize);
+    __atomic_store_n(&header->state, SEGMENT_READY, __ATOMIC_RELEASE);
+
+    munmap(segment, segmentSize);
+    close(fd);
+}
@@ -0,0 +1,16 @@
+/*
+ * CSSE2310 A1
+ * UQWordLadder
+ * Dictionaries shared between game processes through POSIX shared memory.
+ */
+
+#ifndef SHARED_DICT_H
+#define SHARED_DICT_H
+
+#include "dictionary.h"
+
+Dictionary* shared_dictionary_attach(const char* filePath, int length);
+void shared_dictionary_publish(const char* filePath, int length,
+	const Dictionary* dict);
+
+#endif
@@ -10,9 +10,26 @@
 #include <string.h>
 #include <ctype.h>
 #include <stdbool.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "dictionary.h"
+#include "sharedDict.h"
+#include "deletionIndex.h"
+#include "wordGraph.h"
+#include "reorder.h"
+#include "lexicon.h"
+#include "ladderIndex.h"
+#include "landmarks.h"
+#include "latch.h"
+#include "lineReader.h"
+#include "elapsed.h"
 
 #define USAGE_ERR "Usage: uqwordladder [--from fromWord] [--to endWord] "\
-    "[--limit stepLimit] [--length len] [--dictfile filename]"
+    "[--limit stepLimit] [--length len] [--dictfile filename] " \
+    "[--allow-resize] [--reorder bfs|rcm] [--index prefix] " \
+    "[--apply-edits filename] [--check-index] [--distances] " \
+    "[--landmarks count] [--stats]"
 #define NON_LETTER_ERR "uqwordladder: Words must not contain non-letters"
 #define LENGTH_ERR "uqwordladder: Word lengths must be from 2 to 9" \
     " (inclusive)"
@@ -28,15 +45,18 @@
 #define DIFF_WORD_ERR_CODE 10
 #define LIMIT_ERR_CODE 5 
 #define FILEPATH_ERR_CODE 11
+#define EDITS_ERR_CODE 12
+#define INDEX_ERR_CODE 13
+#define INDEX_CHECK_ERR_CODE 14
 
-#define INPUT_BUFFER 100
 #define DICT_LINE_BUFFER 51
 #define DEFAULT_LIMIT 20
 #define MAX_LIMIT 60
 #define DEFAULT_LENGTH 4
 #define MIN_LENGTH 2
-#define MAX_LENGTH 9
 #define DEFAULT_DICT "/usr/share/dict/words"
+#define DEFAULT_LANDMARKS 8
+#define NUM_OPTIONS 13
 
 #define VALID_MOVE 3
 #define GAME_NOT_OVER 2
@@ -44,11 +64,35 @@
 #define USER_WON 0
 #define USER_GAVE_UP 1
 
+/* LexiconLoad
+ * -----------
+ * A lexicon being loaded on a background thread while the game starts. The
+ * lexicon may only be used once the loaded latch has been released. Setting
+ * isCancelled asks the thread to stop before the next word length.
+ */
+typedef struct {
+    int argc;
+    char** argv;
+    int length;
+    pthread_t thread;
+    bool isThreaded;
+    Latch loaded;
+    bool isCancelled;
+    Lexicon* lexicon;
+    int failedLength;
+    IndexStatus failedStatus;
+    double loadMsec;
+    double waitMsec;
+} LexiconLoad;
+
 // Initialise functions
 int user_move(char* userInput, char** oldWords, char* endWord,
-	int stepNumber, char** dictWords, int dictLength);
+	int stepNumber, LexiconLoad* load);
 void check_all_errors(int argc, char** argv, char** validOptions); 
-void check_num_options(int argc); 
+bool is_flag_option(char* option);
+int option_step(char* option);
+bool find_flag(int argc, char** argv, char* flag);
+void check_num_options(int argc, char** argv); 
 void check_unexpected_option(int argc, char** argv, char** validOptions);
 void check_repeated_option(int argc, char** argv, char** validOptions);
 void check_length_limit(int argc, char** argv); 
@@ -61,31 +105,65 @@ void check_word_validity(int argc, char** argv);
 char* convert_capital(char* word); 
 void check_limit(int argc, char** argv); 
 void check_dictionary(int argc, char** argv); 
+void check_reorder(int argc, char** argv);
+void check_index_options(int argc, char** argv);
+void check_distance_options(int argc, char** argv);
 char* get_word(int argc, char** argv, char* option, int length); 
 int get_limit(int argc, char** argv); 
 char* get_dict_word(FILE* file, int length); 
 char** get_dictionary(int argc, char** argv, int length, int* dictLength); 
-int compare_words(char* firstWord, char* secondWord); 
+char* index_path(char* prefix, int length);
+LadderIndex* open_index(int argc, char** argv, int length, bool writable,
+	IndexStatus* status);
+void exit_index_error(int argc, char** argv, int length, IndexStatus status);
+Dictionary* load_dictionary(int argc, char** argv, int length,
+	WordGraph** graph, IndexStatus* status);
+Lexicon* load_lexicon(int argc, char** argv, int length,
+	const bool* cancelled, int* failedLength, IndexStatus* failedStatus);
+void* load_lexicon_thread(void* arg);
+void start_lexicon_load(LexiconLoad* load, int argc, char** argv,
+	int length);
+Lexicon* await_lexicon(LexiconLoad* load);
+void finish_lexicon_load(LexiconLoad* load);
+bool parse_edit(char* line, char* sign, char** word);
+char** read_edits(char* filePath, int* numEdits);
+void apply_edits(int argc, char** argv, char** edits, int numEdits);
+bool check_indexes(int argc, char** argv);
+void maintain_indexes(int argc, char** argv);
+void answer_distance_query(char* line, int length, Dictionary* dictionary,
+	WordGraph* graph, LandmarkOracle* oracle);
+void answer_distance_queries(int argc, char** argv);
+int compare_words(const char* firstWord, const char* secondWord); 
+int compare_positions(const void* first, const void* second);
+void print_suggestion(const char* word, int* isSuggestions);
+bool is_old_word(const char* word, char** oldWords, int numOfMoves);
+void print_graph_suggestions(char** oldWords, char* endWord,
+	int numOfMoves, Dictionary* dictionary, WordGraph* graph, int id,
+	int* isSuggestions);
 void print_suggestions(char** oldWords, char* endWord, int numOfMoves, 
-	char** dictionary, int dictLength); 
+	Lexicon* lexicon); 
 bool check_input_word(char* inputWord, char** oldWords, int numOfMoves,
-	char** dictionary, int dictLength);
+	Lexicon* lexicon);
 int is_game_over(char* userInput, char* endWord, int numOfMoves, int limit); 
 void free_allocated_memory(char** arrayOfArrays, int length);
 void exit_game(int exitStatus, int stepNumber); 
 
 int main(int argc, char** argv) {
-    char* validOptions[5] = {"--from", "--to", "--length", "--limit", 
-	    "--dictfile"};
+    char* validOptions[NUM_OPTIONS] = {"--from", "--to", "--length",
+	    "--limit", "--dictfile", "--allow-resize", "--reorder", "--index",
+	    "--apply-edits", "--check-index", "--distances", "--landmarks",
+	    "--stats"};
 
     check_all_errors(argc, argv, validOptions);
+    maintain_indexes(argc, argv);
+    answer_distance_queries(argc, argv);
 
     // Initialise required variables for game.
     int length = get_length(argc, argv);
     int stepLimit = get_limit(argc, argv);
     int stepNumber = 1;
-    int dictLength;
-    char** dictWords = get_dictionary(argc, argv, length, &dictLength);
+    LexiconLoad load;
+    start_lexicon_load(&load, argc, argv, length);
     char* fromWord = get_word(argc, argv, "--from", length);
     char* endWord = get_word(argc, argv, "--to", length);
 
@@ -93,34 +171,40 @@ int main(int argc, char** argv) {
 	    "'%s' into '%s' in at most %d steps\n", fromWord, endWord,
 	    stepLimit);
 
-    char buffer[INPUT_BUFFER];
-    char* userInput;
-    char** oldWords = malloc(sizeof(char*) * stepNumber);
-    oldWords[stepNumber - 1] = strdup(fromWord);
+    // The game ends once stepNumber passes stepLimit, so every word
+    // entered fits in space allocated up front.
+    LineReader* reader = line_reader_new(STDIN_FILENO);
+    char** oldWords = malloc(sizeof(char*) * (stepLimit + 1));
+    char* wordStore = malloc(WORD_BUFFER * (stepLimit + 1));
+    oldWords[stepNumber - 1] = strcpy(wordStore, fromWord);
     int exitStatus = GAME_NOT_OVER;
     do {
     	fprintf(stdout, "Enter word %d (or ? for help):\n", stepNumber);
-    	// Get user input
-    	fgets(buffer, sizeof(buffer), stdin);
-    	if (feof(stdin) != 0) {
+    	// Get user input (a last line with no newline means giving up).
+	size_t inputLength;
+	char* userInput = line_reader_next(reader, &inputLength);
+	if (userInput == NULL) {
 	    exitStatus = USER_GAVE_UP;
 	    break;
 	}
-    	userInput = convert_capital(strdup(buffer));
-    	userInput[strlen(userInput) - 1] = '\0';
+	line_upper_case(userInput, inputLength);
 	// Make a move based on user's actions accordingly.
 	int userMove = user_move(userInput, oldWords, endWord, stepNumber,
-		dictWords, dictLength);
+		&load);
 	if (userMove == VALID_MOVE) {
-	    oldWords = realloc(oldWords, sizeof(char*) * (++stepNumber));
-	    oldWords[stepNumber - 1] = userInput;
+	    // Valid words are dictionary words, so they fit in WORD_BUFFER.
+	    oldWords[stepNumber] = strcpy(wordStore + WORD_BUFFER *
+		    stepNumber, userInput);
+	    stepNumber++;
 	}
 	exitStatus = is_game_over(oldWords[stepNumber - 1], endWord,
 		stepNumber, stepLimit);
     } while (exitStatus == GAME_NOT_OVER);
 
-    free_allocated_memory(dictWords, dictLength);
-    free_allocated_memory(oldWords, stepNumber);
+    finish_lexicon_load(&load);
+    line_reader_free(reader);
+    free(wordStore);
+    free(oldWords);
     exit_game(exitStatus, stepNumber);
     return 0;
 }
@@ -133,22 +217,21 @@ int main(int argc, char** argv) {
  * oldWords: an array of previously input words.
  * endWord: the final word needed for a win.
  * stepNumber: the number of steps the user has currently made.
- * dictWords: an array of arrays of the dictionary of valid words.
- * dictLength: the length of the dictionary.
+ * load: the loading lexicon of the game, which is waited for here.
  *
  * Returns: VALID_MOVE if the user inputs a valid word, otherwise returns 0.
  */
 int user_move(char* userInput, char** oldWords, char* endWord,
-	int stepNumber, char** dictWords, int dictLength) {
+	int stepNumber, LexiconLoad* load) {
     // Print suggestions if user inputs "?"
     if (strcmp(userInput, "?") == 0) {
-	    print_suggestions(oldWords, endWord, stepNumber, dictWords, 
-		    dictLength);
+	    print_suggestions(oldWords, endWord, stepNumber,
+		    await_lexicon(load));
 	    return 0;
     }
     // Check if the input is valid.
     bool valid_input = check_input_word(userInput, oldWords, stepNumber,
-	    dictWords, dictLength);
+	    await_lexicon(load));
     if (valid_input) {
 	    return VALID_MOVE;
     }
@@ -167,7 +250,7 @@ int user_move(char* userInput, char** oldWords, char* endWord,
  * 	error. Specific exit status and message is in corresponding functions
  */
 void check_all_errors(int argc, char** argv, char** validOptions) {
-    check_num_options(argc);
+    check_num_options(argc, argv);
     check_repeated_option(argc, argv, validOptions);
     check_unexpected_option(argc, argv, validOptions);
     check_length_limit(argc, argv);
@@ -175,19 +258,74 @@ void check_all_errors(int argc, char** argv, char** validOptions) {
     check_word_validity(argc, argv);
     check_limit(argc, argv);
     check_dictionary(argc, argv);
+    check_reorder(argc, argv);
+    check_index_options(argc, argv);
+    check_distance_options(argc, argv);
+}
+
+/* is_flag_option()
+ * ----------------
+ * Checks if an option is a flag, i.e. it is not followed by a value.
+ *
+ * option: the command line option to check.
+ *
+ * Returns: true if the option is a flag.
+ */
+bool is_flag_option(char* option) {
+    return strcmp(option, "--allow-resize") == 0 ||
+	    strcmp(option, "--check-index") == 0 ||
+	    strcmp(option, "--distances") == 0 ||
+	    strcmp(option, "--stats") == 0;
+}
+
+/* option_step()
+ * -------------
+ * Gets the number of command line arguments taken up by an option.
+ *
+ * option: the command line option.
+ *
+ * Returns: 1 for a flag, or 2 for an option followed by its value.
+ */
+int option_step(char* option) {
+    return is_flag_option(option) ? 1 : 2;
+}
+
+/* find_flag()
+ * -----------
+ * Checks if a flag was given in the command line options.
+ *
+ * argc: the number of command line options
+ * argv: an array of arrays of the command line options and their values
+ * flag: the flag to look for.
+ *
+ * Returns: true if the flag was given.
+ */
+bool find_flag(int argc, char** argv, char* flag) {
+    for (int i = 1; i < argc; i += option_step(argv[i])) {
+	if (strcmp(argv[i], flag) == 0) {
+	    return true;
+	}
+    }
+    return false;
 }
 
 /* check_num_options()
  * -------------------
- * Checks if number of options given are in odd numbers and less than 11.
+ * Checks if every option which needs a value is followed by one.
  *
  * argc: the number of command line options
+ * argv: an array of arrays of the command line options and their values
  *
  * Errors: Program exits with exit status of 7 and prints usage error if 
  * 	number of command line options is invalid.
  */
-void check_num_options(int argc) {
-    if (argc > 11 || (argc % 2) == 0) {
+void check_num_options(int argc, char** argv) {
+    int i = 1;
+    while (i < argc) {
+	i += option_step(argv[i]);
+    }
+    // Overshooting argc means the last option is missing its value.
+    if (i != argc) {
 	fprintf(stderr, "%s\n", USAGE_ERR);
 	exit(USAGE_ERR_CODE);
     }
@@ -205,17 +343,17 @@ void check_num_options(int argc) {
  * 	are not in validOptions.
  */
 void check_unexpected_option(int argc, char** argv, char** validOptions) {
-    for (int i = 1; i < argc; i += 2) {
-	// numInvalid increases to 5 if option is invalid because it is
-	// compared with each valid option.
+    for (int i = 1; i < argc; i += option_step(argv[i])) {
+	// numInvalid increases to NUM_OPTIONS if option is invalid because it
+	// is compared with each valid option.
 	int numInvalid = 0;
-	for (int j = 0; j < 5; ++j) {
+	for (int j = 0; j < NUM_OPTIONS; ++j) {
 	    if (strcmp(argv[i], validOptions[j]) != 0) {
 		numInvalid++;
 	    }
 	}
 	// Print invalid usage error if an unexpected option is input.
-	if (numInvalid == 5) {
+	if (numInvalid == NUM_OPTIONS) {
 	    fprintf(stderr, "%s\n", USAGE_ERR);
 	    exit(USAGE_ERR_CODE);
 	}
@@ -234,12 +372,12 @@ void check_unexpected_option(int argc, char** argv, char** validOptions) {
  * 	are repeated.
  */
 void check_repeated_option(int argc, char** argv, char** validOptions) {
-    // Compare each validOptions[5] with command-line options.
-    for (int j = 0; j < 5; ++j) {
+    // Compare each validOptions[NUM_OPTIONS] with command-line options.
+    for (int j = 0; j < NUM_OPTIONS; ++j) {
 	// numValid stores number of times each option is seen.
 	// It must be 1 or 0.
 	int numValid = 0;
-	for (int i = 1; i < argc; i += 2) {
+	for (int i = 1; i < argc; i += option_step(argv[i])) {
 	    if (strcmp(argv[i], validOptions[j]) == 0) {
 		numValid++;
 	    }
@@ -264,7 +402,7 @@ void check_repeated_option(int argc, char** argv, char** validOptions) {
  * 	null if the option cannot be found in argv.
  */
 char* find_arg_value(int argc, char** argv, char* option) {
-    for (int i = 1; i < argc; i += 2) {
+    for (int i = 1; i < argc; i += option_step(argv[i])) {
 	if (strcmp(argv[i], option) == 0) {
 	    return argv[i + 1];
 	}
@@ -311,20 +449,30 @@ void check_length_limit(int argc, char** argv) {
  * argv: an array of arrays of the command line options and their values
  *
  * Errors: Exits with exit status of 6 and prints word length error if words
- * 	and length are inconsistent. It also exits with exit status of 15 if
- * 	the length is less than 2 or greater than 9.
+ * 	and length are inconsistent (unless --allow-resize is given). It also
+ * 	exits with exit status of 15 if the length or the length of either
+ * 	word is less than 2 or greater than 9.
  */
 void check_length_validity(int argc, char** argv) {
     // Get options' values.
     char* fromWord = find_arg_value(argc, argv, "--from");
     char* endWord = find_arg_value(argc, argv, "--to");
     int length = get_length(argc, argv);
+    bool allowResize = find_flag(argc, argv, "--allow-resize");
 
     // Check if --from or --to is given and compare and validate lengths.
     char* values[] = {fromWord, endWord};
     for (int i = 0; i < 2; ++i) {
 	if (values[i] != NULL) {
-	    if (strlen(values[i]) != length) {
+	    // Words may differ in length if letters can be added or removed,
+	    // but each must still be a valid length.
+	    int wordLength = strlen(values[i]);
+	    if (allowResize && (wordLength < MIN_LENGTH ||
+		    wordLength > MAX_WORD_LENGTH)) {
+		fprintf(stderr, "%s\n", LENGTH_ERR);
+		exit(LENGTH_ERR_CODE);
+	    }
+	    if (!allowResize && wordLength != length) {
 		fprintf(stderr, "%s\n", WORD_LENGTH_ERR);
 		exit(WORD_LENGTH_ERR_CODE);
 	    }
@@ -332,7 +480,7 @@ void check_length_validity(int argc, char** argv) {
     }
 
     // Check if length is valid.
-    if (length < MIN_LENGTH || length > MAX_LENGTH) {
+    if (length < MIN_LENGTH || length > MAX_WORD_LENGTH) {
 	fprintf(stderr, "%s\n", LENGTH_ERR);
 	exit(LENGTH_ERR_CODE);
     }
@@ -479,6 +627,88 @@ void check_dictionary(int argc, char** argv) {
     fclose(dictFile);
 }
 
+/* check_reorder()
+ * ---------------
+ * Checks if the user-specified reordering method is valid.
+ *
+ * argc: the number of command line options
+ * argv: an array of arrays of the command line options and their values
+ *
+ * Errors: Exits with exit status of 7 and prints usage error if the method
+ * 	is not "bfs" or "rcm".
+ */
+void check_reorder(int argc, char** argv) {
+    char* method = find_arg_value(argc, argv, "--reorder");
+    ReorderMethod parsed;
+    if (method != NULL && !reorder_parse(method, &parsed)) {
+	fprintf(stderr, "%s\n", USAGE_ERR);
+	exit(USAGE_ERR_CODE);
+    }
+}
+
+/* check_index_options()
+ * ---------------------
+ * Checks that index maintenance is only asked for along with an index, and
+ * 	that the edits file can be opened.
+ *
+ * argc: the number of command line options
+ * argv: an array of arrays of the command line options and their values
+ *
+ * Errors: Exits with exit status of 7 and prints usage error if
+ * 	--apply-edits or --check-index is given without --index. Exits with
+ * 	exit status of 11 and prints filepath error if the edits file cannot
+ * 	be opened.
+ */
+void check_index_options(int argc, char** argv) {
+    char* editsPath = find_arg_value(argc, argv, "--apply-edits");
+    if (find_arg_value(argc, argv, "--index") == NULL && (editsPath != NULL
+	    || find_flag(argc, argv, "--check-index"))) {
+	fprintf(stderr, "%s\n", USAGE_ERR);
+	exit(USAGE_ERR_CODE);
+    }
+    if (editsPath == NULL) {
+	return;
+    }
+    FILE* editsFile = fopen(editsPath, "r");
+    if (editsFile == NULL) {
+	fprintf(stderr, "uqwordladder: File named \"%s\" cannot be "
+		"opened\n", editsPath);
+	exit(FILEPATH_ERR_CODE);
+    }
+    fclose(editsFile);
+}
+
+/* check_distance_options()
+ * ------------------------
+ * Checks the options of distance queries.
+ *
+ * argc: the number of command line options
+ * argv: an array of arrays of the command line options and their values
+ *
+ * Errors: Exits with exit status of 7 and prints usage error if the number
+ * 	of landmarks is not from 1 to 16, if --landmarks is given without
+ * 	--distances, or if --distances is given with --allow-resize (ladder
+ * 	lengths are only worked out for one word length).
+ */
+void check_distance_options(int argc, char** argv) {
+    char* landmarks = find_arg_value(argc, argv, "--landmarks");
+    bool distances = find_flag(argc, argv, "--distances");
+    if ((landmarks != NULL && !distances) || (distances &&
+	    find_flag(argc, argv, "--allow-resize"))) {
+	fprintf(stderr, "%s\n", USAGE_ERR);
+	exit(USAGE_ERR_CODE);
+    }
+    if (landmarks == NULL) {
+	return;
+    }
+    char* end;
+    long numLandmarks = strtol(landmarks, &end, 10);
+    if (*end != '\0' || numLandmarks < 1 || numLandmarks > MAX_LANDMARKS) {
+	fprintf(stderr, "%s\n", USAGE_ERR);
+	exit(USAGE_ERR_CODE);
+    }
+}
+
 /* get_length()
  * -------------
  * Gets the length value from the user-specified words or length option.
@@ -600,7 +830,7 @@ char* get_dict_word(FILE* file, int length) {
  * 	words in dictionary which helps to check valid user input in game.
  *
  * Returns: an array of arrays with all valid words from dictionary with
- * 	required length.
+ * 	required length (which is empty if there are none).
  */
 char** get_dictionary(int argc, char** argv, int length, int* dictLength) {
     // Check if user has specified file, otherwise open default dictionary.
@@ -611,8 +841,8 @@ char** get_dictionary(int argc, char** argv, int length, int* dictLength) {
 
     // Open the file and make an array with dynamically allocated memory.
     FILE* file = fopen(filePath, "r");
-    int numOfWords = 1;
-    char** words = malloc(numOfWords * sizeof(char*));
+    int numOfWords = 0;
+    char** words = malloc(sizeof(char*));
     char* word;
 
     while (feof(file) == 0) {
@@ -621,22 +851,598 @@ char** get_dictionary(int argc, char** argv, int length, int* dictLength) {
 	    if (word == NULL) {
 	        continue;
 	    }
-        // Put each character into the array of arrays.
-        words[numOfWords - 1] = word;
-
-        // Allocate more memory for the next word.
-        words = realloc(words, sizeof(char*) * ++numOfWords);
-        words[numOfWords - 1] = malloc(sizeof(char) * (length + 1));
+        // Allocate more memory and put the word into the array of arrays.
+        words = realloc(words, sizeof(char*) * (numOfWords + 1));
+        words[numOfWords++] = word;
     }
-
-    // Remove last array in words[] because it is empty or contains invalid
-    // word.
-    free(words[(numOfWords--) - 1]);
     fclose(file);
     *dictLength = numOfWords;
     return words;
 }
 
+/* index_path()
+ * ------------
+ * Gets the path of the index file for one word length.
+ *
+ * prefix: the value of the --index option.
+ * length: the word length.
+ *
+ * Returns: a pointer to the path "prefix.length", which must be freed.
+ */
+char* index_path(char* prefix, int length) {
+    char* path = malloc(strlen(prefix) + 3);
+    sprintf(path, "%s.%d", prefix, length);
+    return path;
+}
+
+/* open_index()
+ * ------------
+ * Opens the index of the words with the required length, first building it
+ * 	from the dictionary file if it does not exist yet. An existing index
+ * 	is never rebuilt, as it holds the edits applied to it.
+ *
+ * argc: the number of command line options
+ * argv: an array of arrays of the command line options and their values
+ * length: the required length of each word.
+ * writable: true to open the index for editing.
+ * status: a pointer to store the status from ladder_index_open() in.
+ *
+ * Returns: the opened index, or NULL if it cannot be built or opened.
+ */
+LadderIndex* open_index(int argc, char** argv, int length, bool writable,
+	IndexStatus* status) {
+    char* path = index_path(find_arg_value(argc, argv, "--index"), length);
+    LadderIndex* index = ladder_index_open(path, length, writable, status);
+    if (*status == INDEX_MISSING) {
+	int dictLength;
+	char** dictWords = get_dictionary(argc, argv, length, &dictLength);
+	if (ladder_index_create(path, dictWords, dictLength, length)) {
+	    index = ladder_index_open(path, length, writable, status);
+	}
+	free_allocated_memory(dictWords, dictLength);
+    }
+    free(path);
+    return index;
+}
+
+/* exit_index_error()
+ * ------------------
+ * Reports an index which cannot be used. Only called on the main thread,
+ * 	so nothing else is writing output when the process exits.
+ *
+ * argc: the number of command line options
+ * argv: an array of arrays of the command line options and their values
+ * length: the length of the words in the index.
+ * status: why the index cannot be used.
+ *
+ * Errors: Exits with exit status of 13 and prints an index error, which
+ * 	says how to recover an index left half-edited by a crash.
+ */
+void exit_index_error(int argc, char** argv, int length, IndexStatus status) {
+    char* path = index_path(find_arg_value(argc, argv, "--index"), length);
+    if (status == INDEX_DIRTY) {
+	fprintf(stderr, "uqwordladder: Index \"%s\" was left part way "
+		"through edits - delete it to rebuild it from the "
+		"dictionary\n", path);
+    } else {
+	fprintf(stderr, "uqwordladder: Index \"%s\" cannot be used\n",
+		path);
+    }
+    free(path);
+    exit(INDEX_ERR_CODE);
+}
+
+/* load_dictionary()
+ * -----------------
+ * Gets the dictionary of valid words with the required length. If --index
+ * 	is given, the dictionary and its one-letter graph come from the
+ * 	index. Otherwise it attaches to a copy shared by another game process
+ * 	if there is one, or reads the dictionary file with get_dictionary()
+ * 	and publishes the result for later processes.
+ *
+ * argc: the number of command line options
+ * argv: an array of arrays of the command line options and their values
+ * length: the required length of each word.
+ * graph: a pointer to store the one-letter graph in, or NULL if it was not
+ * 	loaded.
+ * status: a pointer to store why the index cannot be used in.
+ *
+ * Returns: the dictionary of valid words, or NULL if the index cannot be
+ * 	used.
+ */
+Dictionary* load_dictionary(int argc, char** argv, int length,
+	WordGraph** graph, IndexStatus* status) {
+    *graph = NULL;
+    if (find_arg_value(argc, argv, "--index") != NULL) {
+	LadderIndex* index = open_index(argc, argv, length, false, status);
+	if (index == NULL) {
+	    return NULL;
+	}
+	Dictionary* dictionary = ladder_index_dictionary(index, graph);
+	*status = dictionary == NULL ? INDEX_INVALID : INDEX_OK;
+	ladder_index_close(index);
+	return dictionary;
+    }
+    char* filePath = find_arg_value(argc, argv, "--dictfile");
+    if (filePath == NULL) {
+	filePath = DEFAULT_DICT;
+    }
+    Dictionary* dictionary = shared_dictionary_attach(filePath, length);
+    if (dictionary != NULL) {
+	return dictionary;
+    }
+
+    int dictLength;
+    char** dictWords = get_dictionary(argc, argv, length, &dictLength);
+    dictionary = dictionary_build(dictWords, dictLength, length);
+    free_allocated_memory(dictWords, dictLength);
+    shared_dictionary_publish(filePath, length, dictionary);
+    return dictionary;
+}
+
+/* load_lexicon()
+ * --------------
+ * Loads the dictionaries needed for the game: every word length if letters
+ * 	may be added or removed, otherwise only the required length. If
+ * 	--reorder is given, each dictionary is renumbered along its
+ * 	one-letter graph and the measurements are printed to stderr. Graphs
+ * 	loaded from an index are kept for suggestions.
+ *
+ * argc: the number of command line options
+ * argv: an array of arrays of the command line options and their values
+ * length: the required length of each word.
+ * cancelled: a pointer to a flag which stops loading once it is set, or
+ * 	NULL if loading cannot be cancelled.
+ * failedLength: a pointer to store the word length of an index which
+ * 	cannot be used in.
+ * failedStatus: a pointer to store why that index cannot be used in.
+ *
+ * Returns: the lexicon of the game, or NULL if an index cannot be used or
+ * 	loading was cancelled.
+ */
+Lexicon* load_lexicon(int argc, char** argv, int length,
+	const bool* cancelled, int* failedLength, IndexStatus* failedStatus) {
+    Lexicon* lexicon = lexicon_new();
+    bool allowResize = find_flag(argc, argv, "--allow-resize");
+    int minLength = allowResize ? MIN_LENGTH : length;
+    int maxLength = allowResize ? MAX_WORD_LENGTH : length;
+    ReorderMethod method = REORDER_NONE;
+    char* methodName = find_arg_value(argc, argv, "--reorder");
+    if (methodName != NULL) {
+	reorder_parse(methodName, &method);
+    }
+
+    for (int len = minLength; len <= maxLength; len++) {
+	if (cancelled != NULL && __atomic_load_n(cancelled, __ATOMIC_ACQUIRE)) {
+	    lexicon_free(lexicon);
+	    return NULL;
+	}
+	lexicon->dictionaries[len] = load_dictionary(argc, argv, len,
+		&lexicon->graphs[len], failedStatus);
+	if (lexicon->dictionaries[len] == NULL) {
+	    *failedLength = len;
+	    lexicon_free(lexicon);
+	    return NULL;
+	}
+	if (method != REORDER_NONE) {
+	    if (lexicon->graphs[len] == NULL) {
+		lexicon->graphs[len] = word_graph_build(
+			lexicon->dictionaries[len]);
+	    }
+	    reorder_words(&lexicon->dictionaries[len], &lexicon->graphs[len],
+		    method, stderr);
+	}
+    }
+    if (allowResize) {
+	lexicon->deletions = deletion_index_build(lexicon->dictionaries,
+		MIN_LENGTH, MAX_WORD_LENGTH);
+    }
+    return lexicon;
+}
+
+/* load_lexicon_thread()
+ * ---------------------
+ * Loads the lexicon of a game and releases the loaded latch, so that the
+ * 	game can start while dictionaries are read and indexed.
+ *
+ * arg: a pointer to the LexiconLoad to fill in.
+ *
+ * Returns: NULL.
+ */
+void* load_lexicon_thread(void* arg) {
+    LexiconLoad* load = arg;
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    load->lexicon = load_lexicon(load->argc, load->argv, load->length,
+	    &load->isCancelled, &load->failedLength, &load->failedStatus);
+    load->loadMsec = elapsed_msec(&start);
+    latch_release(&load->loaded);
+    return NULL;
+}
+
+/* start_lexicon_load()
+ * --------------------
+ * Starts loading the lexicon of a game on a background thread (or loads it
+ * 	straight away if no thread can be started).
+ *
+ * load: the LexiconLoad to start.
+ * argc: the number of command line options
+ * argv: an array of arrays of the command line options and their values
+ * length: the required length of each word.
+ */
+void start_lexicon_load(LexiconLoad* load, int argc, char** argv,
+	int length) {
+    load->argc = argc;
+    load->argv = argv;
+    load->length = length;
+    load->isCancelled = false;
+    load->lexicon = NULL;
+    load->loadMsec = 0;
+    load->waitMsec = 0;
+    latch_init(&load->loaded);
+    load->isThreaded = pthread_create(&load->thread, NULL,
+	    load_lexicon_thread, load) == 0;
+    if (!load->isThreaded) {
+	load_lexicon_thread(load);
+    }
+}
+
+/* await_lexicon()
+ * ---------------
+ * Gets the lexicon of a game, waiting for it to finish loading if it has
+ * 	not yet. Time spent waiting is added to the game's stats.
+ *
+ * load: the LexiconLoad of the game.
+ *
+ * Returns: the loaded lexicon.
+ *
+ * Errors: Exits with exit status of 13 and prints an index error if the
+ * 	lexicon could not be loaded from the index. The loading thread only
+ * 	records the failure, so that it is reported here on the main thread.
+ */
+Lexicon* await_lexicon(LexiconLoad* load) {
+    load->waitMsec += latch_wait(&load->loaded);
+    if (load->lexicon == NULL) {
+	if (load->isThreaded) {
+	    pthread_join(load->thread, NULL);
+	}
+	exit_index_error(load->argc, load->argv, load->failedLength,
+		load->failedStatus);
+    }
+    return load->lexicon;
+}
+
+/* finish_lexicon_load()
+ * ---------------------
+ * Stops the loading thread if no move needed the lexicon, frees the
+ * 	lexicon and prints the loading stats to stderr if --stats is given.
+ * 	The thread stops before its next word length, so this waits for at
+ * 	most the length being loaded (including any reordering of it). A
+ * 	failure of a load the game never needed is not reported.
+ *
+ * load: the LexiconLoad of the game.
+ */
+void finish_lexicon_load(LexiconLoad* load) {
+    __atomic_store_n(&load->isCancelled, true, __ATOMIC_RELEASE);
+    latch_wait(&load->loaded);
+    if (load->isThreaded) {
+	pthread_join(load->thread, NULL);
+    }
+    if (find_flag(load->argc, load->argv, "--stats")) {
+	fprintf(stderr, "uqwordladder: loaded dictionaries in %.3f ms, "
+		"waited %.3f ms for them\n", load->loadMsec, load->waitMsec);
+    }
+    if (load->lexicon != NULL) {
+	lexicon_free(load->lexicon);
+    }
+    latch_destroy(&load->loaded);
+}
+
+/* parse_edit()
+ * ------------
+ * Parses one line of an edits file: "+WORD" adds a word and "-WORD" removes
+ * 	one. Blank lines and lines starting with '#' are ignored.
+ *
+ * line: the line, without its newline, which is capitalised in place.
+ * sign: a pointer to store '+' or '-' in, or '\0' for an ignored line.
+ * word: a pointer to store a pointer to the word (within line) in.
+ *
+ * Returns: true if the line is valid.
+ */
+bool parse_edit(char* line, char* sign, char** word) {
+    *sign = '\0';
+    if (line[0] == '\0' || line[0] == '#') {
+	return true;
+    }
+    if (line[0] != '+' && line[0] != '-') {
+	return false;
+    }
+    *word = convert_capital(line + 1);
+    int wordLength = strlen(*word);
+    if (wordLength < MIN_LENGTH || wordLength > MAX_WORD_LENGTH) {
+	return false;
+    }
+    for (int i = 0; i < wordLength; i++) {
+	if (isalpha((*word)[i]) == 0) {
+	    return false;
+	}
+    }
+    *sign = line[0];
+    return true;
+}
+
+/* read_edits()
+ * ------------
+ * Reads and checks a whole edits file before any of it is applied.
+ *
+ * filePath: the path of the edits file.
+ * numEdits: a pointer to store the number of edits in.
+ *
+ * Returns: an array of arrays of edits, each "+WORD" or "-WORD" in capitals.
+ *
+ * Errors: Exits with exit status of 12 and prints an edit error if any line
+ * 	is not a valid edit.
+ */
+char** read_edits(char* filePath, int* numEdits) {
+    FILE* file = fopen(filePath, "r");
+    char** edits = malloc(sizeof(char*));
+    char* line = NULL;
+    size_t lineSize = 0;
+    int lineNumber = 0;
+    *numEdits = 0;
+    while (getline(&line, &lineSize, file) != -1) {
+	lineNumber++;
+	line[strcspn(line, "\n")] = '\0';
+	char sign;
+	char* word;
+	if (!parse_edit(line, &sign, &word)) {
+	    fprintf(stderr, "uqwordladder: Invalid edit on line %d of "
+		    "\"%s\"\n", lineNumber, filePath);
+	    exit(EDITS_ERR_CODE);
+	}
+	if (sign != '\0') {
+	    edits = realloc(edits, sizeof(char*) * (*numEdits + 1));
+	    edits[(*numEdits)++] = strdup(line);
+	}
+    }
+    free(line);
+    fclose(file);
+    return edits;
+}
+
+/* apply_edits()
+ * -------------
+ * Applies edits, in order, to the indexes of the lengths they touch. Each
+ * 	edit only updates the word and its neighbours, not the whole index.
+ * 	A summary of each index edited is printed.
+ *
+ * argc: the number of command line options
+ * argv: an array of arrays of the command line options and their values
+ * edits: an array of arrays of edits from read_edits().
+ * numEdits: the number of edits.
+ *
+ * Errors: Exits with exit status of 13 and prints an index error if an
+ * 	index cannot be opened or written.
+ */
+void apply_edits(int argc, char** argv, char** edits, int numEdits) {
+    for (int len = MIN_LENGTH; len <= MAX_WORD_LENGTH; len++) {
+	LadderIndex* index = NULL;
+	int numAdded = 0;
+	int numRemoved = 0;
+	for (int i = 0; i < numEdits; i++) {
+	    char* word = edits[i] + 1;
+	    if ((int)strlen(word) != len) {
+		continue;
+	    }
+	    if (index == NULL) {
+		IndexStatus status;
+		index = open_index(argc, argv, len, true, &status);
+		if (index == NULL) {
+		    exit_index_error(argc, argv, len, status);
+		}
+		if (!ladder_index_begin_edits(index)) {
+		    exit_index_error(argc, argv, len, INDEX_UNAVAILABLE);
+		}
+	    }
+	    bool changed;
+	    bool written = edits[i][0] == '+' ?
+		    ladder_index_add(index, word, &changed) :
+		    ladder_index_remove(index, word, &changed);
+	    if (!written) {
+		exit_index_error(argc, argv, len, INDEX_UNAVAILABLE);
+	    }
+	    if (changed && edits[i][0] == '+') {
+		numAdded++;
+	    } else if (changed) {
+		numRemoved++;
+	    }
+	}
+	if (index != NULL) {
+	    ladder_index_end_edits(index);
+	    fprintf(stdout, "uqwordladder: %s: %d added, %d removed, %d "
+		    "words\n", index->path, numAdded, numRemoved,
+		    ladder_index_num_words(index));
+	    ladder_index_close(index);
+	}
+    }
+}
+
+/* check_indexes()
+ * ---------------
+ * Compares every existing index against a full rebuild from its words, and
+ * 	prints the result for each.
+ *
+ * argc: the number of command line options
+ * argv: an array of arrays of the command line options and their values
+ *
+ * Returns: true if every index is consistent.
+ */
+bool check_indexes(int argc, char** argv) {
+    char* prefix = find_arg_value(argc, argv, "--index");
+    bool consistent = true;
+    for (int len = MIN_LENGTH; len <= MAX_WORD_LENGTH; len++) {
+	char* path = index_path(prefix, len);
+	IndexStatus status;
+	LadderIndex* index = ladder_index_open(path, len, false, &status);
+	if (status == INDEX_DIRTY) {
+	    fprintf(stdout, "uqwordladder: %s: edits were interrupted\n",
+		    path);
+	    consistent = false;
+	} else if (status == INDEX_INVALID) {
+	    fprintf(stdout, "uqwordladder: %s: invalid index\n", path);
+	    consistent = false;
+	} else if (status == INDEX_UNAVAILABLE) {
+	    fprintf(stdout, "uqwordladder: %s: cannot be opened\n", path);
+	    consistent = false;
+	} else if (index != NULL) {
+	    int problems = ladder_index_check(index, stdout);
+	    if (problems == 0) {
+		fprintf(stdout, "uqwordladder: %s: consistent, %d words\n",
+			path, ladder_index_num_words(index));
+	    } else {
+		fprintf(stdout, "uqwordladder: %s: %d problems\n", path,
+			problems);
+		consistent = false;
+	    }
+	    ladder_index_close(index);
+	}
+	free(path);
+    }
+    return consistent;
+}
+
+/* maintain_indexes()
+ * ------------------
+ * Applies --apply-edits and then runs --check-index if either is given,
+ * 	instead of playing a game.
+ *
+ * argc: the number of command line options
+ * argv: an array of arrays of the command line options and their values
+ *
+ * Errors: Exits with exit status of 0 once maintenance is done, or exits
+ * 	with exit status of 14 if an index is not consistent. Errors from
+ * 	read_edits() and apply_edits() exit with their own statuses.
+ */
+void maintain_indexes(int argc, char** argv) {
+    char* editsPath = find_arg_value(argc, argv, "--apply-edits");
+    bool check = find_flag(argc, argv, "--check-index");
+    if (editsPath == NULL && !check) {
+	return;
+    }
+    if (editsPath != NULL) {
+	int numEdits;
+	char** edits = read_edits(editsPath, &numEdits);
+	apply_edits(argc, argv, edits, numEdits);
+	free_allocated_memory(edits, numEdits);
+    }
+    if (check && !check_indexes(argc, argv)) {
+	exit(INDEX_CHECK_ERR_CODE);
+    }
+    exit(0);
+}
+
+/* answer_distance_query()
+ * -----------------------
+ * Prints the number of steps between the two words on a line, found with
+ * 	landmark-guided A* search, and how it compares with plain
+ * 	breadth-first search.
+ *
+ * line: the line holding two words separated by spaces.
+ * length: the length of the words.
+ * dictionary: the dictionary of valid words of that length.
+ * graph: the one-letter graph of dictionary.
+ * oracle: the landmark oracle of graph.
+ *
+ * Returns: void, however it prints the answer.
+ */
+void answer_distance_query(char* line, int length, Dictionary* dictionary,
+	WordGraph* graph, LandmarkOracle* oracle) {
+    char* fromWord = strtok(line, " \t\n");
+    char* endWord = strtok(NULL, " \t\n");
+    if (fromWord == NULL) {
+	return;
+    }
+    int source = dictionary_find(dictionary, convert_capital(fromWord));
+    int target = endWord == NULL ? DICT_NOT_FOUND :
+	    dictionary_find(dictionary, convert_capital(endWord));
+    if (source == DICT_NOT_FOUND || target == DICT_NOT_FOUND) {
+	fprintf(stdout, "Words should be %d letter words from the dictionary "
+		"- try again.\n", length);
+	return;
+    }
+
+    struct timespec start;
+    int searchedAStar, searchedBfs;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int steps = landmark_search(oracle, dictionary, graph, compare_words,
+	    source, target, &searchedAStar);
+    double msecAStar = elapsed_msec(&start);
+    landmark_bfs(oracle, graph, source, target, &searchedBfs);
+    double msecBfs = elapsed_msec(&start);
+
+    if (steps == NO_LADDER) {
+	fprintf(stdout, "%s %s: no ladder", fromWord, endWord);
+    } else {
+	fprintf(stdout, "%s %s: %d steps", fromWord, endWord, steps);
+    }
+    fprintf(stdout, " (A* searched %d words in %.3f ms, BFS searched %d "
+	    "words in %.3f ms, speedup %.1fx)\n", searchedAStar, msecAStar,
+	    searchedBfs, msecBfs, msecAStar > 0 ? msecBfs / msecAStar : 1.0);
+}
+
+/* answer_distance_queries()
+ * -------------------------
+ * If --distances is given, answers "how many steps from one word to
+ * 	another" for each line of stdin instead of playing a game. Landmarks
+ * 	are chosen for the required length first, and what they cost is
+ * 	printed to stderr.
+ *
+ * argc: the number of command line options
+ * argv: an array of arrays of the command line options and their values
+ *
+ * Errors: Exits with exit status of 0 once stdin is finished.
+ */
+void answer_distance_queries(int argc, char** argv) {
+    if (!find_flag(argc, argv, "--distances")) {
+	return;
+    }
+    int length = get_length(argc, argv);
+    char* landmarks = find_arg_value(argc, argv, "--landmarks");
+    int numLandmarks = landmarks == NULL ? DEFAULT_LANDMARKS :
+	    atoi(landmarks);
+    int failedLength;
+    IndexStatus failedStatus;
+    Lexicon* lexicon = load_lexicon(argc, argv, length, NULL, &failedLength,
+	    &failedStatus);
+    if (lexicon == NULL) {
+	exit_index_error(argc, argv, failedLength, failedStatus);
+    }
+    Dictionary* dictionary = lexicon->dictionaries[length];
+    if (lexicon->graphs[length] == NULL) {
+	lexicon->graphs[length] = word_graph_build(dictionary);
+    }
+    WordGraph* graph = lexicon->graphs[length];
+
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    LandmarkOracle* oracle = landmark_oracle_build(graph, numLandmarks);
+    fprintf(stderr, "uqwordladder: %d landmarks for %d words of length %d "
+	    "(%zu bytes) in %.3f ms\n", oracle->numLandmarks,
+	    dictionary->numWords, length,
+	    (size_t)oracle->numLandmarks * dictionary->numWords,
+	    elapsed_msec(&start));
+
+    char* line = NULL;
+    size_t lineSize = 0;
+    while (getline(&line, &lineSize, stdin) != -1) {
+	answer_distance_query(line, length, dictionary, graph, oracle);
+    }
+    free(line);
+    landmark_oracle_free(oracle);
+    lexicon_free(lexicon);
+    exit(0);
+}
+
 /* compare_words()
  * ---------------
  * Compares two words of same length to get the number of the differences.
@@ -647,7 +1453,7 @@ char** get_dictionary(int argc, char** argv, int length, int* dictLength) {
  * Returns: the number of character differences between two words of same
  * 	length.
  */
-int compare_words(char* firstWord, char* secondWord) {
+int compare_words(const char* firstWord, const char* secondWord) {
     int wordLength = strlen(firstWord);
     int numOfDiff = 0;
     for (int i = 0; i < wordLength; i++) {
@@ -658,6 +1464,92 @@ int compare_words(char* firstWord, char* secondWord) {
     return numOfDiff;
 }
 
+/* print_suggestion()
+ * ------------------
+ * Prints one suggestion, preceded by the suggestions header if it is the
+ * 	first one.
+ *
+ * word: the suggested word.
+ * isSuggestions: a pointer to a flag which is 1 once the header has been
+ * 	printed.
+ *
+ * Returns: void, however it prints the suggestion.
+ */
+void print_suggestion(const char* word, int* isSuggestions) {
+    if (*isSuggestions == 0) {
+	*isSuggestions = 1;
+	fprintf(stdout, "Suggestions:-----------\n");
+    }
+    fprintf(stdout, " %s\n", word);
+}
+
+/* is_old_word()
+ * -------------
+ * Checks if a word has already been entered.
+ *
+ * word: the word to look for.
+ * oldWords: an array of arrays of previously entered words.
+ * numOfMoves: the number of words in oldWords.
+ *
+ * Returns: true if word is one of oldWords.
+ */
+bool is_old_word(const char* word, char** oldWords, int numOfMoves) {
+    for (int j = 0; j < numOfMoves; j++) {
+	if (strcmp(oldWords[j], word) == 0) {
+	    return true;
+	}
+    }
+    return false;
+}
+
+/* compare_positions()
+ * -------------------
+ * qsort() comparator which orders file positions ascending.
+ */
+int compare_positions(const void* first, const void* second) {
+    int a = *(const int*)first;
+    int b = *(const int*)second;
+    return (a > b) - (a < b);
+}
+
+/* print_graph_suggestions()
+ * -------------------------
+ * Prints the neighbours of a dictionary word in its one-letter graph, in
+ * 	file order, excluding endWord and previous words.
+ *
+ * oldWords: an array of arrays of previously entered words.
+ * endWord: the final word which is needed to win.
+ * numOfMoves: the number of words in oldWords.
+ * dictionary: the dictionary of valid words of the current length.
+ * graph: the one-letter graph of dictionary.
+ * id: the id in dictionary of the current word.
+ * isSuggestions: a pointer to a flag which is 1 once the suggestions header
+ * 	has been printed.
+ *
+ * Returns: void, however it prints any valid suggestions.
+ */
+void print_graph_suggestions(char** oldWords, char* endWord,
+	int numOfMoves, Dictionary* dictionary, WordGraph* graph, int id,
+	int* isSuggestions) {
+    int degree = word_graph_degree(graph, id);
+    const uint32_t* neighbours = graph->neighbours + graph->offsets[id];
+    // Sort the neighbours' file positions to list them in file order.
+    int* positions = malloc(sizeof(int) * (degree + 1));
+    for (int i = 0; i < degree; i++) {
+	positions[i] = dictionary_file_position(dictionary, neighbours[i]);
+    }
+    qsort(positions, degree, sizeof(int), compare_positions);
+    for (int i = 0; i < degree; i++) {
+	const char* word = dictionary_word(dictionary,
+		dictionary_file_id(dictionary, positions[i]));
+	if (strcmp(word, endWord) != 0 &&
+		!is_old_word(word, oldWords, numOfMoves)) {
+	    print_suggestion(word, isSuggestions);
+	}
+    }
+    free(positions);
+}
+
 /* print_suggestions()
  * -------------------
  * Prints the valid suggestions from dictionary based on the current word and
@@ -667,49 +1559,57 @@ int compare_words(char* firstWord, char* secondWord) {
  * endWord: the final word which is needed to win.
  * numOfMoves: the number of moves the user has made in the game (which helps
  * 	iterate through oldWords).
- * dictionary: an array of arrays of valid words of the required length.
- * dictLength: the number of words in the dictionary (which helps iterate
- * 	through the dictionary).
+ * lexicon: the dictionaries of valid words for the lengths in play.
  *
  * Returns: void, however it prints any valid suggestions.
  */
 void print_suggestions(char** oldWords, char* endWord, int numOfMoves, 
-	char** dictionary, int dictLength) {
+	Lexicon* lexicon) {
 
     int isSuggestions = 0;
+    char* lastWord = oldWords[numOfMoves - 1];
+    DeletionIndex* deletions = lexicon->deletions;
+    Dictionary* dictionary = lexicon->dictionaries[strlen(lastWord)];
+    WordGraph* graph = lexicon->graphs[strlen(lastWord)];
+    int id = graph == NULL ? DICT_NOT_FOUND :
+	    dictionary_find(dictionary, lastWord);
 
     // Print endWord if it is one move away from latest input word.
-    int numOfDiff = compare_words(oldWords[numOfMoves - 1], endWord);
-    if (numOfDiff == 1) {
-	isSuggestions = 1;
-	fprintf(stdout, "Suggestions:-----------\n");
-	fprintf(stdout, " %s\n", endWord);
-    }
-    // Print all words from dictionary with one letter difference by 
-    // comparing current word with all words in dictionary.
-    for (int i = 0; i < dictLength; i++) {
-	numOfDiff = compare_words(oldWords[numOfMoves - 1], dictionary[i]);
-	if (numOfDiff == 1) {
-	    if (strcmp(dictionary[i], endWord) == 0) {
-		continue;
-	    }
-	    // Exclude any previously entered words.
-	    int inOldWord = 0;
-	    for (int j = 0; j < numOfMoves; j++) {
-		if (strcmp(oldWords[j], dictionary[i]) == 0) {
-		    inOldWord = 1;
-		    break;
-		}
+    if (is_one_edit(lastWord, endWord)) {
+	print_suggestion(endWord, &isSuggestions);
+    }
+    if (deletions != NULL) {
+	// Look up the words one letter added, removed or changed away.
+	uint32_t neighbours[DELETION_MAX_NEIGHBOURS];
+	int numNeighbours = deletion_index_neighbours(deletions, lastWord,
+		neighbours);
+	for (int i = 0; i < numNeighbours; i++) {
+	    const char* word = dictionary_word(
+		    lexicon->dictionaries[DELETION_REF_LENGTH(neighbours[i])],
+		    DELETION_REF_ID(neighbours[i]));
+	    if (strcmp(word, endWord) != 0 &&
+		    !is_old_word(word, oldWords, numOfMoves)) {
+		print_suggestion(word, &isSuggestions);
 	    }
-	    if (inOldWord == 1) {
+	}
+    } else if (id != DICT_NOT_FOUND) {
+	print_graph_suggestions(oldWords, endWord, numOfMoves, dictionary,
+		graph, id, &isSuggestions);
+    } else {
+	// Print all words from dictionary with one letter difference by 
+	// comparing current word with all words in dictionary (in file
+	// order, in case it has been reordered).
+	for (int i = 0; i < dictionary->numWords; i++) {
+	    const char* word = dictionary_word(dictionary,
+		    dictionary_file_id(dictionary, i));
+	    if (compare_words(lastWord, word) != 1 ||
+		    strcmp(word, endWord) == 0) {
 		continue;
 	    }
-	    if (isSuggestions == 0) {
-		isSuggestions = 1;
-		fprintf(stdout, "Suggestions:-----------\n");
+	    // Exclude any previously entered words.
+	    if (!is_old_word(word, oldWords, numOfMoves)) {
+		print_suggestion(word, &isSuggestions);
 	    }
-
-	    fprintf(stdout, " %s\n", dictionary[i]);
 	}
     }
     if (isSuggestions == 1) {
@@ -727,24 +1627,35 @@ void print_suggestions(char** oldWords, char* endWord, int numOfMoves,
  * oldWords: an array of arrays of previously entered words.
  * numOfMoves: the number of moves the user has made in the game (which helps
  * 	iterate through oldWords).
- * dictionary: an array of arrays of valid words of the required length.
- * dictLength: the number of words in the dictionary (which helps iterate
- * 	through the dictionary).
+ * lexicon: the dictionaries of valid words for the lengths in play.
  *
  * Returns: true if word is correct length, one character different to
- * 	previous word, and in the dictionary. Otherwise it returns false.
+ * 	previous word (or one character added or removed if letters may be
+ * 	added or removed), and in the dictionary. Otherwise it returns false.
  */
 bool check_input_word(char* inputWord, char** oldWords, int numOfMoves,
-	char** dictionary, int dictLength) {
-    int length = strlen(oldWords[0]);S
+	Lexicon* lexicon) {
+    DeletionIndex* deletions = lexicon->deletions;
+    char* lastWord = oldWords[numOfMoves - 1];
+    int length = strlen(lastWord);
+    int inputLength = strlen(inputWord);
     // Check length
-    if (strlen(inputWord) != length) {
+    if (deletions == NULL && inputLength != length) {
 	fprintf(stdout, "Word should be %d characters long - try again.\n", 
 		length);
 	return false;
     }
+    int minLength = length - 1 < MIN_LENGTH ? MIN_LENGTH : length - 1;
+    int maxLength = length + 1 > MAX_WORD_LENGTH ? MAX_WORD_LENGTH :
+	    length + 1;
+    if (deletions != NULL &&
+	    (inputLength < minLength || inputLength > maxLength)) {
+	fprintf(stdout, "Word should be %d to %d characters long - try "
+		"again.\n", minLength, maxLength);
+	return false;
+    }
     // Check if there are non-letters
-    for (int i = 0; i < length; i++) {
+    for (int i = 0; i < inputLength; i++) {
 	if (isalpha(inputWord[i]) == 0) {
 	    fprintf(stdout, "Word should contain only letters - "
 		    "try again.\n");
@@ -753,26 +1664,28 @@ bool check_input_word(char* inputWord, char** oldWords, int numOfMoves,
     }
 
     // Check if there is only one different character
-    if (compare_words(inputWord, oldWords[numOfMoves - 1]) != 1) {
+    if (deletions == NULL && compare_words(inputWord, lastWord) != 1) {
 	fprintf(stdout, "Word should have only one letter different - "
 		"try again.\n");
 	return false;
     }
+    if (deletions != NULL && !is_one_edit(inputWord, lastWord)) {
+	fprintf(stdout, "Word should have only one letter added, removed or "
+		"different - try again.\n");
+	return false;
+    }
 
     // Check if input word and any previous words are the same.
-    for (int i = 0; i < numOfMoves; i++) {
-	if (strcmp(inputWord, oldWords[i]) == 0) {
-	    fprintf(stdout, "Previous word can't be repeated - "
-		    "try again.\n");
-	    return false;
-	}
+    if (is_old_word(inputWord, oldWords, numOfMoves)) {
+	fprintf(stdout, "Previous word can't be repeated - "
+		"try again.\n");
+	return false;
     }
 
     // Check if word is in dictionary
-    for (int i = 0; i < dictLength; i++) {
-        if (strcmp(inputWord, dictionary[i]) == 0) {
-            return true;
-        }
+    if (dictionary_find(lexicon->dictionaries[inputLength], inputWord) !=
+	    DICT_NOT_FOUND) {
+	return true;
     }
     fprintf(stdout, "Word not found in dictionary - try again.\n");
     return false;
@@ -791,11 +1704,12 @@ bool check_input_word(char* inputWord, char** oldWords, int numOfMoves,
  * 	word matches end word, or 2 if not game over.
  */
 int is_game_over(char* userInput, char* endWord, int numOfMoves, int limit) {
-    int numDiff = compare_words(userInput, endWord);
-    if (numOfMoves > limit && numDiff != 0) {
+    // Words may have different lengths, so compare them whole.
+    bool isEndWord = strcmp(userInput, endWord) == 0;
+    if (numOfMoves > limit && !isEndWord) {
 	return STEP_LIMIT_EXCEEDED;
     }
-    if (numDiff == 0) {
+    if (isEndWord) {
 	return USER_WON;
     }
     return GAME_NOT_OVER;
@@ -0,0 +1,174 @@
+/*
+ * CSSE2310 A1
+ * UQWordLadder
+ * Graph of the words of one length which are one letter apart.
+ */
+
+#include <stdlib.h>
+#include "wordGraph.h"
+
+/* A word's packed key with one letter masked out. */
+typedef struct {
+    uint64_t masked;
+    uint64_t key;
+    uint32_t id;
+} MaskedWord;
+
+/* compare_masked()
+ * ----------------
+ * qsort() comparator which groups words by their masked key.
+ */
+static int compare_masked(const void* first, const void* second) {
+    const MaskedWord* a = first;
+    const MaskedWord* b = second;
+    if (a->masked != b->masked) {
+	return a->masked < b->masked ? -1 : 1;
+    }
+    return (a->id > b->id) - (a->id < b->id);
+}
+
+/* compare_ids()
+ * -------------
+ * qsort() comparator for word ids.
+ */
+static int compare_ids(const void* first, const void* second) {
+    uint32_t a = *(const uint32_t*)first;
+    uint32_t b = *(const uint32_t*)second;
+    return (a > b) - (a < b);
+}
+
+/* for_each_edge()
+ * ---------------
+ * Finds every pair of words one letter apart. Two words differ only in
+ * 	letter p exactly when their keys are equal with letter p masked out,
+ * 	so sorting by each masked key in turn puts neighbours next to each
+ * 	other. Identical words (duplicates in the file) are not neighbours.
+ *
+ * dict: the dictionary to find edges in.
+ * words: scratch space for numWords masked words.
+ * degrees: if not NULL, the degree of each word is counted in here.
+ * offsets: if not NULL, each edge is written to neighbours at (and then
+ * 	advances) offsets of its first word.
+ * neighbours: the adjacency array filled in when offsets is given.
+ */
+static void for_each_edge(const Dictionary* dict, MaskedWord* words,
+	uint32_t* degrees, uint32_t* offsets, uint32_t* neighbours) {
+    int length = dict->length;
+    for (int p = 0; p < length; p++) {
+	uint64_t mask = ~((uint64_t)0x1F <<
+		(DICT_LETTER_BITS * (length - 1 - p)));
+	for (int id = 0; id < dict->numWords; id++) {
+	    words[id].key = dictionary_key(dictionary_word(dict, id), length);
+	    words[id].masked = words[id].key & mask;
+	    words[id].id = id;
+	}
+	qsort(words, dict->numWords, sizeof(MaskedWord), compare_masked);
+
+	int start = 0;
+	while (start < dict->numWords) {
+	    int end = start;
+	    while (end < dict->numWords &&
+		    words[end].masked == words[start].masked) {
+		end++;
+	    }
+	    for (int a = start; a < end; a++) {
+		for (int b = start; b < end; b++) {
+		    if (words[a].key == words[b].key) {
+			continue;
+		    }
+		    if (degrees != NULL) {
+			degrees[words[a].id]++;
+		    } else {
+			neighbours[offsets[words[a].id]++] = words[b].id;
+		    }
+		}
+	    }
+	    start = end;
+	}
+    }
+}
+
+/* word_graph_build()
+ * ------------------
+ * Builds the one-letter graph of a dictionary.
+ *
+ * dict: the dictionary to build the graph of.
+ *
+ * Returns: a pointer to the new graph, whose word ids match dict.
+ */
+WordGraph* word_graph_build(const Dictionary* dict) {
+    int numWords = dict->numWords;
+    WordGraph* graph = malloc(sizeof(WordGraph));
+    graph->numWords = numWords;
+    graph->offsets = calloc(numWords + 1, sizeof(uint32_t));
+    MaskedWord* words = malloc(sizeof(MaskedWord) * (numWords + 1));
+
+    // Count degrees, then fill each word's slice of the adjacency array.
+    for_each_edge(dict, words, graph->offsets + 1, NULL, NULL);
+    for (int id = 0; id < numWords; id++) {
+	graph->offsets[id + 1] += graph->offsets[id];
+    }
+    graph->neighbours = malloc(sizeof(uint32_t) *
+	    (graph->offsets[numWords] + 1));
+    uint32_t* next = malloc(sizeof(uint32_t) * (numWords + 1));
+    for (int id = 0; id < numWords; id++) {
+	next[id] = graph->offsets[id];
+    }
+    for_each_edge(dict, words, NULL, next, graph->neighbours);
+    for (int id = 0; id < numWords; id++) {
+	qsort(graph->neighbours + graph->offsets[id],
+		word_graph_degree(graph, id), sizeof(uint32_t), compare_ids);
+    }
+    free(next);
+    free(words);
+    return graph;
+}
+
+/* word_graph_permute()
+ * --------------------
+ * Relabels the words of a graph to match a reordered dictionary.
+ *
+ * graph: the graph to relabel.
+ * order: an array of numWords ids, where order[i] is the id in graph of the
+ * 	word which gets id i in the new graph.
+ *
+ * Returns: a pointer to the relabelled graph.
+ */
+WordGraph* word_graph_permute(const WordGraph* graph, const uint32_t* order) {
+    int numWords = graph->numWords;
+    uint32_t* newIds = malloc(sizeof(uint32_t) * (numWords + 1));
+    for (int i = 0; i < numWords; i++) {
+	newIds[order[i]] = i;
+    }
+    WordGraph* permuted = malloc(sizeof(WordGraph));
+    permuted->numWords = numWords;
+    permuted->offsets = malloc(sizeof(uint32_t) * (numWords + 1));
+    permuted->neighbours = malloc(sizeof(uint32_t) *
+	    (graph->offsets[numWords] + 1));
+    permuted->offsets[0] = 0;
+    for (int i = 0; i < numWords; i++) {
+	uint32_t start = permuted->offsets[i];
+	int degree = word_graph_degree(graph, order[i]);
+	const uint32_t* old = graph->neighbours + graph->offsets[order[i]];
+	for (int j = 0; j < degree; j++) {
+	    permuted->neighbours[start + j] = newIds[old[j]];
+	}
+	qsort(permuted->neighbours + start, degree, sizeof(uint32_t),
+		compare_ids);
+	permuted->offsets[i + 1] = start + degree;
+    }
+    free(newIds);
+    return permuted;
+}
+
+/* word_graph_free()
+ * -----------------
+ * Frees a graph.
+ *
+ * graph: the graph to free.
+ */
+void word_graph_free(WordGraph* graph) {
+    free(graph->offsets);
+    free(graph->neighbours);
+    free(graph);
+}
@@ -0,0 +1,37 @@
+/*
+ * CSSE2310 A1
+ * UQWordLadder
+ * Graph of the words of one length which are one letter apart.
+ */
+
+#ifndef WORD_GRAPH_H
+#define WORD_GRAPH_H
+
+#include <stdint.h>
+#include "dictionary.h"
+
+/* WordGraph
+ * ---------
+ * Adjacency of a dictionary in compressed sparse row form: the neighbours
+ * of word id are neighbours[offsets[id]] to neighbours[offsets[id + 1] - 1],
+ * in increasing id order.
+ */
+typedef struct {
+    int numWords;
+    uint32_t* offsets;
+    uint32_t* neighbours;
+} WordGraph;
+
+WordGraph* word_graph_build(const Dictionary* dict);
+WordGraph* word_graph_permute(const WordGraph* graph, const uint32_t* order);
+void word_graph_free(WordGraph* graph);
+
+/* word_graph_degree()
+ * -------------------
+ * Returns: the number of neighbours of the word with the given id.
+ */
+static inline int word_graph_degree(const WordGraph* graph, int id) {
+    return graph->offsets[id + 1] - graph->offsets[id];
+}
+
+#endif